@@ -23,7 +23,10 @@ sns.set_theme()  # This will set seaborn's default theme
 
 # %%
 def load_frequency_data(file_path: str) -> pd.DataFrame:
-    """Load frequency response data from a CSV file."""
+    """Load frequency response data from a CSV file, or its .npy export when present."""
+    npy_path = Path(file_path).with_suffix(".npy")
+    if npy_path.exists():
+        return pd.DataFrame(np.load(npy_path, mmap_mode="r"))
     df = pd.read_csv(file_path)
     return df
 
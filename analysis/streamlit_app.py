@@ -32,7 +32,9 @@ def parse_filename(filename: str) -> Dict[str, str]:
 
 
 def load_frequency_data(file_path: str) -> pd.DataFrame:
-    """Load frequency response data from a CSV file."""
+    """Load frequency response data from a CSV or memory-mapped NumPy (.npy) file."""
+    if file_path.endswith(".npy"):
+        return pd.DataFrame(np.load(file_path, mmap_mode="r"))
     return pd.read_csv(file_path)
 
 
@@ -247,12 +249,13 @@ def main():
     # Sidebar controls
     st.sidebar.header("Filter Selection")
 
-    # Get all CSV files
-    csv_files = list(Path("frequency_responses").glob("*.csv"))
+    # Get all data files, preferring the binary .npy export over a CSV with the same name
+    data_files = {file.stem: file for file in Path("frequency_responses").glob("*.csv")}
+    data_files.update({file.stem: file for file in Path("frequency_responses").glob("*.npy")})
 
     # Parse and organize files
     filter_data = {}
-    for file in csv_files:
+    for file in data_files.values():
         params = parse_filename(file.name)
         if params:
             key = (params["filter_type"], params["order"])
@@ -0,0 +1,432 @@
+#include <DiodeClipper/WDFDiodeClipper.h>
+#include <WDFilters/BandPassFilter.h>
+#include <WDFilters/HighPassFilter.h>
+#include <WDFilters/LowPassFilter.h>
+#include <WDFilters/WDFilter.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "MappedWAVReader.h"
+#include "ParallelScanRenderer.h"
+#include "Utils.h"
+#include "WorkStealingPool.h"
+
+/**
+ * @brief Processing chain applied to every rendered file
+ */
+struct ChainSettings
+{
+    bool            useFilter   = true;
+    WDFilter::Type  filterType  = WDFilter::Type::LowPass;
+    WDFilter::Order filterOrder = WDFilter::Order::First;
+    double          cutoff      = 1000.0;
+    bool            useClipper  = false;
+    float           clipCutoff  = 1000.0f;
+    float           diodeIs     = 2.52e-9f;
+    float           numDiodes   = 2.0f;
+    int             blockSize   = 512;
+
+    utils::WAVStreamWriter::SampleFormat outputFormat = utils::WAVStreamWriter::SampleFormat::PCM16;
+    bool                                 dither       = false;
+};
+
+/**
+ * @brief Per-worker processing engine
+ *
+ * Each worker owns one engine, so no DSP state is ever shared between threads.
+ * The engine keeps one filter and one clipper per channel and is re-prepared for every file.
+ */
+class RenderEngine
+{
+public:
+    void prepare(const ChainSettings& settings, double sampleRate, size_t numChannels)
+    {
+        filters.resize(numChannels);
+        clippers.resize(numChannels);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            if (settings.useFilter)
+            {
+                if (filters[ch] == nullptr || filters[ch]->getType() != settings.filterType ||
+                    filters[ch]->getOrder() != settings.filterOrder)
+                    filters[ch] = WDFilter::create(settings.filterType, settings.filterOrder);
+
+                filters[ch]->prepare(sampleRate);
+                filters[ch]->setCutoff(settings.cutoff);
+            }
+
+            if (settings.useClipper)
+            {
+                if (clippers[ch] == nullptr)
+                    clippers[ch] = std::make_unique<WDFDiodeClipperJUCE>();
+
+                clippers[ch]->prepare(sampleRate);
+                clippers[ch]->setParameters(settings.clipCutoff, settings.diodeIs, settings.numDiodes, true);
+            }
+        }
+    }
+
+    void processBlock(const ChainSettings& settings, size_t channel, float* samples, int numSamples)
+    {
+        if (settings.useFilter)
+            filters[channel]->processBlock(samples, numSamples);
+
+        if (settings.useClipper)
+            clippers[channel]->processBlock(samples, numSamples);
+    }
+
+private:
+    // Held by pointer: the WDF trees reference their own members, so they must stay put when the vectors grow
+    std::vector<std::unique_ptr<WDFilter>>            filters;
+    std::vector<std::unique_ptr<WDFDiodeClipperJUCE>> clippers;
+};
+
+/**
+ * @brief Render a single file through the chain
+ * @param engine Engine owned by the calling worker
+ * @param settings Processing chain
+ * @param inputPath WAV file to render
+ * @param outputPath Destination WAV file
+ * @param audioSeconds Receives the duration of the file in seconds
+ * @return True if the file was rendered successfully
+ */
+static bool renderFile(RenderEngine&        engine,
+                       const ChainSettings& settings,
+                       const fs::path&      inputPath,
+                       const fs::path&      outputPath,
+                       double&              audioSeconds)
+{
+    utils::MappedWAVReader reader;
+    if (!reader.open(inputPath))
+        return false;
+
+    const double   sampleRate  = reader.getSampleRate();
+    const size_t   numChannels = static_cast<size_t>(reader.getNumChannels());
+    const uint64_t numFrames   = reader.getNumFrames();
+    engine.prepare(settings, sampleRate, numChannels);
+
+    utils::WAVStreamWriter writer;
+    if (!writer.open(outputPath, sampleRate, static_cast<int>(numChannels), settings.outputFormat, settings.dither))
+        return false;
+
+    // Only one block per channel is ever held in memory; the reader converts it straight from the mapped file
+    const size_t                    blockSize = static_cast<size_t>(settings.blockSize);
+    std::vector<std::vector<float>> blocks(numChannels, std::vector<float>(blockSize));
+    std::vector<float*>             blockPointers(numChannels);
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        blockPointers[ch] = blocks[ch].data();
+
+    for (uint64_t start = 0; start < numFrames; start += blockSize)
+    {
+        const size_t numInBlock = reader.readFrames(start, blockSize, blockPointers.data());
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+            engine.processBlock(settings, ch, blockPointers[ch], static_cast<int>(numInBlock));
+
+        if (!writer.write(blockPointers.data(), numInBlock))
+            return false;
+    }
+
+    audioSeconds = static_cast<double>(numFrames) / sampleRate;
+    return writer.close();
+}
+
+/**
+ * @brief Render a single file with the filter split into chunks across the pool (utils::ParallelScanRenderer)
+ *
+ * The file is read in segments of a few chunks per worker, so memory stays bounded however long it is.
+ * The clipper is not linear; it runs sequentially on each segment after the filter.
+ * @param pool Pool the chunks run on
+ * @param engine Engine for the clipper
+ * @param settings Processing chain; the filter must be enabled
+ * @param chunkSize Samples per chunk
+ * @param inputPath WAV file to render
+ * @param outputPath Destination WAV file
+ * @param audioSeconds Receives the duration of the file in seconds
+ * @return True if the file was rendered successfully
+ */
+static bool renderFileParallelScan(utils::WorkStealingPool& pool,
+                                   RenderEngine&            engine,
+                                   const ChainSettings&     settings,
+                                   size_t                   chunkSize,
+                                   const fs::path&          inputPath,
+                                   const fs::path&          outputPath,
+                                   double&                  audioSeconds)
+{
+    utils::MappedWAVReader reader;
+    if (!reader.open(inputPath))
+        return false;
+
+    const double   sampleRate  = reader.getSampleRate();
+    const size_t   numChannels = static_cast<size_t>(reader.getNumChannels());
+    const uint64_t numFrames   = reader.getNumFrames();
+
+    ChainSettings clipperOnly = settings;
+    clipperOnly.useFilter     = false;
+    engine.prepare(clipperOnly, sampleRate, numChannels);
+
+    const auto createFilter = [&settings, sampleRate] {
+        auto filter = WDFilter::create(settings.filterType, settings.filterOrder);
+        filter->prepare(sampleRate);
+        filter->setCutoff(settings.cutoff);
+        return filter;
+    };
+
+    std::vector<std::unique_ptr<utils::ParallelScanRenderer>> scans;
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        scans.push_back(std::make_unique<utils::ParallelScanRenderer>(pool, createFilter, chunkSize));
+
+    utils::WAVStreamWriter writer;
+    if (!writer.open(outputPath, sampleRate, static_cast<int>(numChannels), settings.outputFormat, settings.dither))
+        return false;
+
+    // Four chunks per worker and segment, so the workers stay busy while the chunks differ in cost
+    const size_t segmentSize = scans.front()->getChunkSize() * static_cast<size_t>(pool.getNumWorkers()) * 4;
+    std::vector<std::vector<float>> segments(numChannels, std::vector<float>(segmentSize));
+    std::vector<float*>             segmentPointers(numChannels);
+    for (size_t ch = 0; ch < numChannels; ++ch)
+        segmentPointers[ch] = segments[ch].data();
+
+    const size_t blockSize = static_cast<size_t>(settings.blockSize);
+    for (uint64_t start = 0; start < numFrames; start += segmentSize)
+    {
+        const size_t numInSegment = reader.readFrames(start, segmentSize, segmentPointers.data());
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            scans[ch]->process(segmentPointers[ch], numInSegment);
+
+            for (size_t offset = 0; offset < numInSegment; offset += blockSize)
+            {
+                const auto numInBlock = static_cast<int>(std::min(blockSize, numInSegment - offset));
+                engine.processBlock(clipperOnly, ch, segmentPointers[ch] + offset, numInBlock);
+            }
+        }
+
+        if (!writer.write(segmentPointers.data(), numInSegment))
+            return false;
+    }
+
+    audioSeconds = static_cast<double>(numFrames) / sampleRate;
+    return writer.close();
+}
+
+static bool parseSampleFormat(const std::string& name, utils::WAVStreamWriter::SampleFormat& format)
+{
+    if (name == "pcm16")
+        format = utils::WAVStreamWriter::SampleFormat::PCM16;
+    else if (name == "pcm24")
+        format = utils::WAVStreamWriter::SampleFormat::PCM24;
+    else if (name == "float")
+        format = utils::WAVStreamWriter::SampleFormat::Float32;
+    else
+        return false;
+    return true;
+}
+
+static bool parseFilterType(const std::string& name, WDFilter::Type& type)
+{
+    if (name == "lp" || name == "lowpass")
+        type = WDFilter::Type::LowPass;
+    else if (name == "hp" || name == "highpass")
+        type = WDFilter::Type::HighPass;
+    else if (name == "bp" || name == "bandpass")
+        type = WDFilter::Type::BandPass;
+    else
+        return false;
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    ChainSettings         settings;
+    int                   numThreads   = 0;
+    bool                  parallelScan = false;
+    size_t                chunkSize    = utils::ParallelScanRenderer::defaultChunkSize;
+    fs::path              outputDir    = fs::current_path() / "rendered";
+    std::vector<fs::path> inputs;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc)
+        {
+            std::string name = argv[++i];
+            if (name == "none")
+                settings.useFilter = false;
+            else if (!parseFilterType(name, settings.filterType))
+            {
+                std::cerr << "Unknown filter type: " << name << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--order" && i + 1 < argc)
+            settings.filterOrder = std::stoi(argv[++i]) >= 2 ? WDFilter::Order::Second : WDFilter::Order::First;
+        else if (arg == "--cutoff" && i + 1 < argc)
+            settings.cutoff = std::stod(argv[++i]);
+        else if (arg == "--clipper")
+            settings.useClipper = true;
+        else if (arg == "--clip-cutoff" && i + 1 < argc)
+            settings.clipCutoff = std::stof(argv[++i]);
+        else if (arg == "--is" && i + 1 < argc)
+            settings.diodeIs = std::stof(argv[++i]);
+        else if (arg == "--diodes" && i + 1 < argc)
+            settings.numDiodes = std::stof(argv[++i]);
+        else if (arg == "--block" && i + 1 < argc)
+            settings.blockSize = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--threads" && i + 1 < argc)
+            numThreads = std::stoi(argv[++i]);
+        else if (arg == "--parallel-scan")
+            parallelScan = true;
+        else if (arg == "--chunk" && i + 1 < argc)
+            chunkSize = static_cast<size_t>(std::max(1024, std::stoi(argv[++i])));
+        else if (arg == "--out" && i + 1 < argc)
+            outputDir = argv[++i];
+        else if (arg == "--format" && i + 1 < argc)
+        {
+            std::string name = argv[++i];
+            if (!parseSampleFormat(name, settings.outputFormat))
+            {
+                std::cerr << "Unknown output format: " << name << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--dither")
+            settings.dither = true;
+        else if (arg == "--help")
+        {
+            std::cout << "Usage: BatchRenderer [options] <input.wav>..." << std::endl
+                      << "Options:" << std::endl
+                      << "  --filter <type>       lp, hp, bp or none (default: lp)" << std::endl
+                      << "  --order <1|2>         Filter order (default: 1)" << std::endl
+                      << "  --cutoff <value>      Filter cutoff/center frequency in Hz (default: 1000)" << std::endl
+                      << "  --clipper             Append the diode clipper to the chain" << std::endl
+                      << "  --clip-cutoff <value> Clipper cutoff frequency (default: 1000)" << std::endl
+                      << "  --is <value>          Diode saturation current (default: 2.52e-9)" << std::endl
+                      << "  --diodes <value>      Number of diodes in series (default: 2.0)" << std::endl
+                      << "  --block <samples>     Processing block size (default: 512)" << std::endl
+                      << "  --threads <n>         Worker threads (default: hardware concurrency)" << std::endl
+                      << "  --parallel-scan       Split each file's filter into chunks across the threads" << std::endl
+                      << "                        (files render one at a time; for long single files)" << std::endl
+                      << "  --chunk <samples>     Chunk length for --parallel-scan (default: 65536)" << std::endl
+                      << "  --out <dir>           Output directory (default: ./rendered)" << std::endl
+                      << "  --format <fmt>        pcm16, pcm24 or float (default: pcm16)" << std::endl
+                      << "  --dither              Apply TPDF dither when writing PCM" << std::endl
+                      << "  --help                Show this help message" << std::endl;
+            return 0;
+        }
+        else
+            inputs.emplace_back(arg);
+    }
+
+    if (inputs.empty())
+    {
+        std::cerr << "No input files given (see --help)" << std::endl;
+        return 1;
+    }
+
+    // Inputs with the same name from different directories would render into one file from two workers at once
+    std::vector<fs::path>      outputs;
+    std::map<fs::path, size_t> inputForOutput;
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        outputs.push_back(outputDir / (inputs[i].stem().string() + "_rendered.wav"));
+        const auto [entry, inserted] = inputForOutput.emplace(outputs.back(), i);
+        if (!inserted)
+        {
+            std::cerr << "Inputs " << inputs[entry->second].string() << " and " << inputs[i].string()
+                      << " would both render to " << outputs.back().string() << "; rename one of them" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!utils::createDirectory(outputDir))
+    {
+        std::cerr << "Failed to create output directory" << std::endl;
+        return 1;
+    }
+
+    utils::WorkStealingPool   pool(numThreads);
+    std::vector<RenderEngine> engines(static_cast<size_t>(pool.getNumWorkers()));
+
+    std::cout << "Rendering " << inputs.size() << " file(s) on " << pool.getNumWorkers() << " thread(s)..."
+              << std::endl;
+    std::cout << "Output directory: " << outputDir.string() << std::endl;
+
+    std::mutex          logMutex;
+    std::atomic<int>    numFailed{0};
+    std::atomic<double> totalAudioSeconds{0.0};
+
+    using clock   = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+
+    if (parallelScan && settings.useFilter)
+    {
+        // One file at a time on this thread; the pool runs the chunks of each file
+        std::cout << "Parallel scan over chunks of " << chunkSize << " samples" << std::endl;
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            const fs::path& input  = inputs[i];
+            const fs::path& output = outputs[i];
+
+            double audioSeconds = 0.0;
+            if (renderFileParallelScan(pool, engines.front(), settings, chunkSize, input, output, audioSeconds))
+                std::cout << "Rendered " << output.filename().string() << std::endl;
+            else
+            {
+                ++numFailed;
+                std::cerr << "Failed to render " << input.string() << std::endl;
+            }
+            totalAudioSeconds = totalAudioSeconds.load() + audioSeconds;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            // inputs and outputs outlive the tasks, so only the index is copied
+            pool.submit([&, i](int workerIndex) {
+                const fs::path& input  = inputs[i];
+                const fs::path& output = outputs[i];
+
+                double     audioSeconds = 0.0;
+                const bool ok =
+                    renderFile(engines[static_cast<size_t>(workerIndex)], settings, input, output, audioSeconds);
+
+                // atomic<double> has no fetch_add before C++20
+                double expected = totalAudioSeconds.load();
+                while (!totalAudioSeconds.compare_exchange_weak(expected, expected + audioSeconds))
+                {
+                }
+
+                std::lock_guard<std::mutex> lock(logMutex);
+                if (ok)
+                    std::cout << "Rendered " << output.filename().string() << std::endl;
+                else
+                {
+                    ++numFailed;
+                    std::cerr << "Failed to render " << input.string() << std::endl;
+                }
+            });
+        }
+
+        pool.wait();
+    }
+
+    const double wallSec = std::chrono::duration<double>(clock::now() - t0).count();
+    std::cout << "\nRendered " << totalAudioSeconds.load() << " s of audio in " << wallSec
+              << " s (RTF = " << (totalAudioSeconds.load() > 0.0 ? wallSec / totalAudioSeconds.load() : 0.0) << ")"
+              << std::endl;
+
+    return numFailed.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,619 @@
+#include <DiodeClipper/WDFDiodeClipper.h>
+#include <WDFilters/BandPassFilter.h>
+#include <WDFilters/CascadeFilter.h>
+#include <WDFilters/Crossover.h>
+#include <WDFilters/HighPassFilter.h>
+#include <WDFilters/LowPassFilter.h>
+#include <WDFilters/LowPassVoiceBank.h>
+#include <WDFilters/OpAmpFilter.h>
+#include <WDFilters/StateVariableFilter.h>
+#include <WDFilters/WDFilter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Utils.h"
+#include "wdf_core/MathConstants.h"
+#include "wdf_core/ScopedNoDenormals.h"
+
+// Input signals are this long and read cyclically, so every block sees fresh samples
+static constexpr size_t sourceLength = 65536;
+
+// Number of cutoff values cycled through by the parameter-update benchmarks
+static constexpr size_t numCutoffs = 64;
+
+/**
+ * @brief Keeps the compiler from optimising away work whose result is only reachable through pointer
+ */
+static void escape(const void* pointer)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ __volatile__("" : : "g"(pointer) : "memory");
+#else
+    static const void* volatile sink;
+    sink = pointer;
+#endif
+}
+
+/**
+ * @brief Uniform interface over the DSP classes under test
+ */
+class BenchmarkTarget
+{
+public:
+    virtual ~BenchmarkTarget() = default;
+
+    virtual std::string getName() const                                                                = 0;
+    virtual std::string getParameterUpdateName() const                                                 = 0;
+    virtual bool        hasDoublePath() const                                                          = 0;
+    virtual bool        hasModulatedPath() const                                                       = 0;
+    virtual int         getNumVoices() const                                                           = 0;
+    virtual void        prepare(double sampleRate)                                                     = 0;
+    virtual void        updateParameters(double cutoffHz)                                              = 0;
+    virtual void        processBlock(float* samples, int numSamples)                                   = 0;
+    virtual void        processBlockModulated(float* samples, const float* cutoffsHz, int numSamples) = 0;
+    virtual void        processSamples(const double* input, double* output, int numSamples)            = 0;
+};
+
+/**
+ * @brief A WDFilter, driven through the same virtual interface the plugin uses
+ */
+class FilterTarget final : public BenchmarkTarget
+{
+public:
+    FilterTarget(std::string className, WDFilter::Type type, WDFilter::Order order)
+        : FilterTarget(std::move(className), WDFilter::create(type, order))
+    {}
+
+    FilterTarget(std::string className, std::unique_ptr<WDFilter> filterToUse)
+        : name(std::move(className))
+        , filter(std::move(filterToUse))
+    {}
+
+    std::string getName() const override { return name; }
+    std::string getParameterUpdateName() const override { return "setCutoff"; }
+    bool        hasDoublePath() const override { return true; }
+    bool        hasModulatedPath() const override { return true; }
+    int         getNumVoices() const override { return 1; }
+    void        prepare(double sampleRate) override { filter->prepare(sampleRate); }
+    void        updateParameters(double cutoffHz) override { filter->setCutoff(cutoffHz); }
+    void        processBlock(float* samples, int numSamples) override { filter->processBlock(samples, numSamples); }
+
+    void processBlockModulated(float* samples, const float* cutoffsHz, int numSamples) override
+    {
+        filter->processBlockModulated(samples, cutoffsHz, numSamples);
+    }
+
+    void processSamples(const double* input, double* output, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = filter->processSample(input[i]);
+    }
+
+private:
+    std::string               name;
+    std::unique_ptr<WDFilter> filter;
+};
+
+/**
+ * @brief The diode clipper; float only, parameters are smoothed unless forced
+ */
+class ClipperTarget final : public BenchmarkTarget
+{
+public:
+    explicit ClipperTarget(bool forceParameters)
+        : forceNow(forceParameters)
+    {}
+
+    std::string getName() const override
+    {
+        return forceNow ? "WDFDiodeClipperJUCE (forceNow)" : "WDFDiodeClipperJUCE";
+    }
+
+    std::string getParameterUpdateName() const override { return "setParameters"; }
+    bool        hasDoublePath() const override { return false; }
+    bool        hasModulatedPath() const override { return false; }
+    int         getNumVoices() const override { return 1; }
+    void        prepare(double sampleRate) override { clipper.prepare(sampleRate); }
+    void        processBlock(float* samples, int numSamples) override { clipper.processBlock(samples, numSamples); }
+    void        processBlockModulated(float*, const float*, int) override {}
+    void        processSamples(const double*, double*, int) override {}
+
+    void updateParameters(double cutoffHz) override
+    {
+        clipper.setParameters(static_cast<float>(cutoffHz), 2.52e-9f, 2.0f, forceNow);
+    }
+
+private:
+    WDFDiodeClipperJUCE clipper;
+    bool                forceNow;
+};
+
+/**
+ * @brief WDFRCLowPassVoiceBank with every voice active, each filtering a copy of the input at its own cutoff
+ */
+class VoiceBankTarget final : public BenchmarkTarget
+{
+public:
+    explicit VoiceBankTarget(int voices)
+        : numVoices(voices)
+        , voiceBuffers(static_cast<size_t>(voices))
+    {}
+
+    std::string getName() const override { return "WDFRCLowPassVoiceBank (x" + std::to_string(numVoices) + ")"; }
+    std::string getParameterUpdateName() const override { return "setCutoff (all voices)"; }
+    bool        hasDoublePath() const override { return false; }
+    bool        hasModulatedPath() const override { return false; }
+    int         getNumVoices() const override { return numVoices; }
+    void        processBlockModulated(float*, const float*, int) override {}
+    void        processSamples(const double*, double*, int) override {}
+
+    void prepare(double sampleRate) override
+    {
+        bank.prepare(sampleRate, numVoices);
+        for (int voice = 0; voice < numVoices; ++voice)
+            bank.activateVoice(voice, 1000.0);
+    }
+
+    // The voices spread over an octave above the cutoff, as if keyboard-tracked
+    void updateParameters(double cutoffHz) override
+    {
+        for (int voice = 0; voice < numVoices; ++voice)
+            bank.setCutoff(voice, cutoffHz * (1.0 + static_cast<double>(voice) / numVoices));
+    }
+
+    void processBlock(float* samples, int numSamples) override
+    {
+        const auto length = static_cast<size_t>(numSamples);
+        if (storage.size() < length * voiceBuffers.size())
+            storage.resize(length * voiceBuffers.size()); // first block of each size only
+
+        for (size_t voice = 0; voice < voiceBuffers.size(); ++voice)
+        {
+            voiceBuffers[voice] = storage.data() + voice * length;
+            std::copy_n(samples, length, voiceBuffers[voice]);
+        }
+
+        bank.processBlock(voiceBuffers.data(), numSamples);
+        std::copy_n(voiceBuffers[0], length, samples);
+    }
+
+private:
+    int                   numVoices;
+    WDFRCLowPassVoiceBank bank;
+    std::vector<float>    storage;
+    std::vector<float*>   voiceBuffers;
+};
+
+/**
+ * @brief WDFCrossover splitting the input into every band in one pass; times are per input sample
+ */
+class CrossoverTarget final : public BenchmarkTarget
+{
+public:
+    CrossoverTarget(int numBands, int order)
+        : crossover(numBands, order)
+        , bandBuffers(static_cast<size_t>(crossover.getNumBands()))
+    {}
+
+    std::string getName() const override
+    {
+        return "WDFCrossover (LR" + std::to_string(crossover.getOrder()) + ", "
+               + std::to_string(crossover.getNumBands()) + " bands)";
+    }
+
+    std::string getParameterUpdateName() const override { return "setCrossovers"; }
+    bool        hasDoublePath() const override { return false; }
+    bool        hasModulatedPath() const override { return false; }
+    int         getNumVoices() const override { return 1; }
+    void        prepare(double sampleRate) override { crossover.prepare(sampleRate); }
+    void        processBlockModulated(float*, const float*, int) override {}
+    void        processSamples(const double*, double*, int) override {}
+
+    // Crossovers an octave apart from the cutoff up
+    void updateParameters(double cutoffHz) override
+    {
+        for (int i = 0; i < crossover.getNumBands() - 1; ++i)
+            crossover.setCrossoverFrequency(i, cutoffHz * std::exp2(i));
+    }
+
+    // The lowest band overwrites the input; the others go to scratch buffers
+    void processBlock(float* samples, int numSamples) override
+    {
+        const auto length = static_cast<size_t>(numSamples);
+        if (storage.size() < length * bandBuffers.size())
+            storage.resize(length * bandBuffers.size()); // first block of each size only
+
+        bandBuffers[0] = samples;
+        for (size_t band = 1; band < bandBuffers.size(); ++band)
+            bandBuffers[band] = storage.data() + band * length;
+
+        crossover.processBlock(samples, bandBuffers.data(), numSamples);
+        escape(storage.data());
+    }
+
+private:
+    WDFCrossover        crossover;
+    std::vector<float>  storage;
+    std::vector<float*> bandBuffers;
+};
+
+struct BenchmarkSettings
+{
+    std::vector<int> blockSizes  = {16, 64, 256, 1024};
+    double           sampleRate  = 48000.0;
+    double           minTime     = 0.02; // seconds per repetition
+    int              repetitions = 5;
+    std::string      classFilter;
+    fs::path         outputFile = fs::current_path() / "dsp_benchmark.json";
+};
+
+struct Measurement
+{
+    double  median     = 0.0;
+    double  min        = 0.0;
+    double  max        = 0.0;
+    int64_t iterations = 0; // calls per repetition
+};
+
+struct BenchmarkResult
+{
+    std::string benchmark;
+    std::string className;
+    std::string sampleType;
+    int         blockSize = 0; // 0 for per-call benchmarks
+    std::string unit;
+    Measurement measurement;
+};
+
+/**
+ * @brief Times a benchmark body
+ *
+ * The iteration count is doubled until one repetition takes at least settings.minTime
+ * (which also warms caches and branch predictors), then the repetitions are timed.
+ * @param body Work for one iteration
+ * @param unitsPerIteration Samples or calls per iteration
+ * @param settings Benchmark settings
+ * @return Nanoseconds per unit over the repetitions
+ */
+template <typename Body>
+static Measurement measure(Body&& body, double unitsPerIteration, const BenchmarkSettings& settings)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto timeIterations = [&body](int64_t iterations) {
+        const auto start = clock::now();
+        for (int64_t i = 0; i < iterations; ++i)
+            body();
+        return std::chrono::duration<double>(clock::now() - start).count();
+    };
+
+    Measurement measurement;
+    measurement.iterations = 1;
+    while (timeIterations(measurement.iterations) < settings.minTime && measurement.iterations < (int64_t{1} << 40))
+        measurement.iterations *= 2;
+
+    std::vector<double> nanoseconds;
+    for (int r = 0; r < settings.repetitions; ++r)
+        nanoseconds.push_back(timeIterations(measurement.iterations) * 1.0e9 /
+                              (static_cast<double>(measurement.iterations) * unitsPerIteration));
+
+    std::sort(nanoseconds.begin(), nanoseconds.end());
+    measurement.min    = nanoseconds.front();
+    measurement.max    = nanoseconds.back();
+    measurement.median = nanoseconds[nanoseconds.size() / 2];
+    return measurement;
+}
+
+/**
+ * @brief Runs every benchmark on one DSP class
+ * @param target Class under test
+ * @param settings Benchmark settings
+ * @param results Receives one entry per benchmark
+ */
+static void runBenchmarks(BenchmarkTarget&              target,
+                          const BenchmarkSettings&      settings,
+                          std::vector<BenchmarkResult>& results)
+{
+    // Identical, reproducible inputs for every class
+    std::mt19937                          generator(1);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::vector<float>                    floatSource(sourceLength);
+    std::vector<double>                   doubleSource(sourceLength);
+    for (size_t i = 0; i < sourceLength; ++i)
+    {
+        floatSource[i]  = noise(generator);
+        doubleSource[i] = floatSource[i];
+    }
+
+    // Log-spaced cutoffs between 50 Hz and 5 kHz, so every update changes the circuit
+    std::vector<double> cutoffs(numCutoffs);
+    for (size_t i = 0; i < numCutoffs; ++i)
+        cutoffs[i] = 50.0 * std::pow(100.0, static_cast<double>(i) / (numCutoffs - 1));
+
+    // Audio-rate modulation over the same range: an exponential sine sweep with a period of 1024 samples
+    std::vector<float> modulation(sourceLength);
+    for (size_t i = 0; i < sourceLength; ++i)
+    {
+        const double phase = std::sin(wdf_core::MathConstants<double>::twoPi * static_cast<double>(i) / 1024.0);
+        modulation[i]      = static_cast<float>(500.0 * std::pow(10.0, phase));
+    }
+
+    auto record = [&](const std::string& benchmark,
+                      const std::string& sampleType,
+                      int                blockSize,
+                      const std::string& unit,
+                      const Measurement& measurement) {
+        results.push_back({benchmark, target.getName(), sampleType, blockSize, unit, measurement});
+    };
+
+    target.prepare(settings.sampleRate);
+    target.updateParameters(1000.0);
+
+    for (int blockSize : settings.blockSizes)
+    {
+        const auto          numSamples = static_cast<size_t>(blockSize);
+        std::vector<float>  floatBlock(numSamples);
+        std::vector<double> doubleBlock(numSamples);
+        size_t              position = 0;
+        size_t              cutoff   = 0;
+
+        // The copy from the source costs well under a nanosecond per sample and keeps the input stationary
+        auto nextFloatBlock = [&]() {
+            if (position + numSamples > sourceLength)
+                position = 0;
+            std::copy_n(floatSource.begin() + static_cast<std::ptrdiff_t>(position), numSamples, floatBlock.begin());
+            position += numSamples;
+        };
+
+        auto processFloat = [&]() {
+            nextFloatBlock();
+            target.processBlock(floatBlock.data(), blockSize);
+            escape(floatBlock.data());
+        };
+
+        auto processDouble = [&]() {
+            if (position + numSamples > sourceLength)
+                position = 0;
+            target.processSamples(doubleSource.data() + position, doubleBlock.data(), blockSize);
+            position += numSamples;
+            escape(doubleBlock.data());
+        };
+
+        // Automation: one parameter update per block, as the plugins do
+        auto processAutomated = [&]() {
+            target.updateParameters(cutoffs[cutoff++ % numCutoffs]);
+            processFloat();
+        };
+
+        // Modulation: a new cutoff every sample
+        auto processModulated = [&]() {
+            nextFloatBlock();
+            const float* blockCutoffs = modulation.data() + (position - numSamples);
+            target.processBlockModulated(floatBlock.data(), blockCutoffs, blockSize);
+            escape(floatBlock.data());
+        };
+
+        // A voice bank processes the block once per voice; its time is per voice and sample
+        const double      units = static_cast<double>(blockSize) * target.getNumVoices();
+        const std::string unit  = target.getNumVoices() > 1 ? "ns/voice-sample" : "ns/sample";
+        record("processBlock", "float", blockSize, unit, measure(processFloat, units, settings));
+        if (target.hasDoublePath())
+            record("processSample", "double", blockSize, unit, measure(processDouble, units, settings));
+        record("processBlockAutomated", "float", blockSize, unit, measure(processAutomated, units, settings));
+        if (target.hasModulatedPath())
+            record("processBlockModulated", "float", blockSize, unit, measure(processModulated, units, settings));
+    }
+
+    size_t cutoff          = 0;
+    auto   updateParameter = [&]() { target.updateParameters(cutoffs[cutoff++ % numCutoffs]); };
+    auto   prepare         = [&]() { target.prepare(settings.sampleRate); };
+
+    record(target.getParameterUpdateName(), "", 0, "ns/call", measure(updateParameter, 1.0, settings));
+    record("prepare", "", 0, "ns/call", measure(prepare, 1.0, settings));
+}
+
+/**
+ * @brief Writes the results as JSON
+ * @param filePath Output file
+ * @param settings Benchmark settings, recorded as context
+ * @param results Benchmark results
+ * @return True if the file was written successfully
+ */
+static bool writeJSON(const fs::path&                     filePath,
+                      const BenchmarkSettings&            settings,
+                      const std::vector<BenchmarkResult>& results)
+{
+    std::ofstream file(filePath);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open file for writing: " << filePath << std::endl;
+        return false;
+    }
+
+    const std::time_t now = std::time(nullptr);
+    char              timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#if defined(__clang__)
+    const std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    const std::string compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    const std::string compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    const std::string compiler = "unknown";
+#endif
+
+#ifdef NDEBUG
+    const bool optimized = true;
+#else
+    const bool optimized = false;
+#endif
+
+    file << std::setprecision(6);
+    file << "{\n"
+         << "  \"context\": {\n"
+         << "    \"timestamp\": \"" << timestamp << "\",\n"
+         << "    \"compiler\": \"" << compiler << "\",\n"
+         << "    \"optimized\": " << (optimized ? "true" : "false") << ",\n"
+         << "    \"sampleRate\": " << settings.sampleRate << ",\n"
+         << "    \"repetitions\": " << settings.repetitions << ",\n"
+         << "    \"minTimePerRepetition\": " << settings.minTime << "\n"
+         << "  },\n"
+         << "  \"benchmarks\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        file << "    {\"benchmark\": \"" << result.benchmark << "\", \"class\": \"" << result.className
+             << "\", \"sampleType\": \"" << result.sampleType << "\", \"blockSize\": " << result.blockSize
+             << ", \"unit\": \"" << result.unit << "\", \"median\": " << result.measurement.median
+             << ", \"min\": " << result.measurement.min << ", \"max\": " << result.measurement.max
+             << ", \"iterations\": " << result.measurement.iterations;
+        if (result.unit == "ns/sample")
+            file << ", \"realTimeFactor\": " << result.measurement.median * 1.0e-9 * settings.sampleRate;
+        file << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    file << "  ]\n"
+         << "}\n";
+
+    return file.good();
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkSettings settings;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--block-sizes" && i + 1 < argc)
+        {
+            settings.blockSizes.clear();
+            std::stringstream list(argv[++i]);
+            std::string       item;
+            while (std::getline(list, item, ','))
+                settings.blockSizes.push_back(std::max(1, std::stoi(item)));
+        }
+        else if (arg == "--fs" && i + 1 < argc)
+            settings.sampleRate = std::stod(argv[++i]);
+        else if (arg == "--min-time" && i + 1 < argc)
+            settings.minTime = std::stod(argv[++i]);
+        else if (arg == "--repetitions" && i + 1 < argc)
+            settings.repetitions = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--filter" && i + 1 < argc)
+            settings.classFilter = argv[++i];
+        else if (arg == "--out" && i + 1 < argc)
+            settings.outputFile = argv[++i];
+        else if (arg == "--help")
+        {
+            std::cout << "Usage: DSPBenchmark [options]" << std::endl
+                      << "Options:" << std::endl
+                      << "  --block-sizes <list>  Block sizes (default: 16,64,256,1024)" << std::endl
+                      << "  --fs <value>          Sample rate in Hz (default: 48000)" << std::endl
+                      << "  --min-time <seconds>  Minimum duration of one repetition (default: 0.02)" << std::endl
+                      << "  --repetitions <n>     Timed repetitions per benchmark (default: 5)" << std::endl
+                      << "  --filter <text>       Only benchmark classes whose name contains this text" << std::endl
+                      << "  --out <file>          JSON output file (default: ./dsp_benchmark.json)" << std::endl
+                      << "  --help                Show this help message" << std::endl;
+            return 0;
+        }
+    }
+
+    std::vector<std::unique_ptr<BenchmarkTarget>> targets;
+    targets.push_back(std::make_unique<FilterTarget>("WDFRCLowPass", WDFilter::Type::LowPass, WDFilter::Order::First));
+    targets.push_back(
+        std::make_unique<FilterTarget>("WDFRC2LowPassCascade", WDFilter::Type::LowPass, WDFilter::Order::Second));
+    targets.push_back(
+        std::make_unique<FilterTarget>("WDFRCHighPass", WDFilter::Type::HighPass, WDFilter::Order::First));
+    targets.push_back(
+        std::make_unique<FilterTarget>("WDFRC2HighPassCascade", WDFilter::Type::HighPass, WDFilter::Order::Second));
+    targets.push_back(
+        std::make_unique<FilterTarget>("WDFRCBandPass1st", WDFilter::Type::BandPass, WDFilter::Order::First));
+    targets.push_back(
+        std::make_unique<FilterTarget>("WDFRCBandPass2nd", WDFilter::Type::BandPass, WDFilter::Order::Second));
+    targets.push_back(std::make_unique<FilterTarget>("WDFRLCBandPass", std::make_unique<WDFRLCBandPass>()));
+    for (int order : {4, 8, 12})
+    {
+        targets.push_back(std::make_unique<FilterTarget>(
+            "WDFCascadeFilter (Butter LP" + std::to_string(order) + ")",
+            std::make_unique<WDFCascadeFilter>(WDFilter::Type::LowPass, wdf_core::Alignment::Butterworth, order)));
+    }
+    targets.push_back(std::make_unique<FilterTarget>(
+        "WDFCascadeFilter (Bessel BP4)",
+        std::make_unique<WDFCascadeFilter>(WDFilter::Type::BandPass, wdf_core::Alignment::Bessel, 4)));
+    for (auto accuracy : {OpAmpModel::Accuracy::Linear, OpAmpModel::Accuracy::Fast, OpAmpModel::Accuracy::Accurate})
+    {
+        // Compare Fast and Accurate with Linear, the same circuit with an ideal op-amp: Fast should stay within 2x.
+        // At 18 dB of drive the noise input reaches the rails, so the saturating paths do real work
+        auto sallenKey = std::make_unique<SallenKeyLowPass>(accuracy);
+        sallenKey->setQ(2.0);
+        sallenKey->setDrive(18.0);
+        targets.push_back(std::make_unique<FilterTarget>(
+            accuracy == OpAmpModel::Accuracy::Linear
+                ? "SallenKeyLowPass (linear)"
+                : (accuracy == OpAmpModel::Accuracy::Fast ? "SallenKeyLowPass (fast)" : "SallenKeyLowPass (tanh)"),
+            std::move(sallenKey)));
+    }
+    targets.push_back(std::make_unique<FilterTarget>(
+        "StateVariableFilter (LP)", std::make_unique<StateVariableFilter>(WDFilter::Type::LowPass)));
+    targets.push_back(std::make_unique<FilterTarget>(
+        "StateVariableFilter (BP)", std::make_unique<StateVariableFilter>(WDFilter::Type::BandPass)));
+    targets.push_back(std::make_unique<CrossoverTarget>(4, 4)); // 30 sections; per-band chains would run 42
+    for (int voices : {32, 128})
+        targets.push_back(std::make_unique<VoiceBankTarget>(voices)); // compare with WDFRCLowPass
+    targets.push_back(std::make_unique<ClipperTarget>(false));
+    targets.push_back(std::make_unique<ClipperTarget>(true));
+
+    // Flush denormals as the plugins' processBlock() does
+    wdf_core::ScopedNoDenormals noDenormals;
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& target : targets)
+    {
+        if (!settings.classFilter.empty() && target->getName().find(settings.classFilter) == std::string::npos)
+            continue;
+
+        std::cout << "Benchmarking " << target->getName() << "..." << std::endl;
+        runBenchmarks(*target, settings, results);
+    }
+
+    if (results.empty())
+    {
+        std::cerr << "No class matches " << settings.classFilter << std::endl;
+        return 1;
+    }
+
+    std::cout << std::endl
+              << std::left << std::setw(24) << "Benchmark" << std::setw(32) << "Class" << std::setw(8) << "Type"
+              << std::right << std::setw(7) << "Block" << std::setw(12) << "Median" << std::setw(12) << "Min"
+              << std::setw(12) << "Max" << "  Unit" << std::endl;
+
+    for (const auto& result : results)
+    {
+        std::cout << std::left << std::setw(24) << result.benchmark << std::setw(32) << result.className
+                  << std::setw(8) << result.sampleType << std::right << std::setw(7)
+                  << (result.blockSize > 0 ? std::to_string(result.blockSize) : "-") << std::fixed
+                  << std::setprecision(2) << std::setw(12) << result.measurement.median << std::setw(12)
+                  << result.measurement.min << std::setw(12) << result.measurement.max << std::defaultfloat << "  "
+                  << result.unit << std::endl;
+    }
+
+    if (!writeJSON(settings.outputFile, settings, results))
+        return 1;
+
+    std::cout << std::endl << "Results written to " << settings.outputFile.string() << std::endl;
+    return 0;
+}
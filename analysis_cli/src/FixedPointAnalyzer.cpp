@@ -0,0 +1,192 @@
+#include <WDFilters/FixedPointFilter.h>
+#include <WDFilters/WDFilter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Utils.h"
+
+struct AnalyzerSettings
+{
+    double              sampleRate = 48000.0;
+    double              seconds    = 2.0;
+    std::vector<double> cutoffs    = {50.0, 200.0, 1000.0, 5000.0, 15000.0};
+    double              minSnrQ31  = 120.0; // dB
+    double              minSnrQ15  = 50.0;  // dB
+    fs::path            outputFile = fs::current_path() / "fixed_point_snr.csv";
+};
+
+struct EngineResult
+{
+    double   snr          = 0.0; // dB against the double engine
+    int      headroomBits = 0;
+    uint64_t hash         = 0; // FNV-1a of the output words, to compare builds bit for bit
+};
+
+/**
+ * @brief Hashes a word into an FNV-1a state, byte by byte from the least significant, independent of endianness
+ */
+template <typename Word>
+static void hashWord(uint64_t& hash, Word word)
+{
+    using Unsigned       = std::make_unsigned_t<Word>;
+    const Unsigned value = static_cast<Unsigned>(word);
+    for (size_t byte = 0; byte < sizeof(Word); ++byte)
+    {
+        hash ^= static_cast<uint8_t>(value >> (8 * byte));
+        hash *= 1099511628211ull;
+    }
+}
+
+/**
+ * @brief Runs the fixed-point engine and the double WDF filter on the same quantised input
+ *
+ * The input is uniform noise at a quarter of full scale (-12 dBFS peak) from a fixed LCG, so the
+ * input words, and therefore the output hash, are identical on every platform; the quarter scale
+ * keeps the overshoot of the high-pass cascades inside the fixed-point range. The reference sees
+ * exactly the quantised input, so the SNR measures the filter's own arithmetic only.
+ */
+template <typename Word>
+static EngineResult analyzeEngine(WDFilter::Type          type,
+                                  WDFilter::Order         order,
+                                  double                  cutoff,
+                                  const AnalyzerSettings& settings)
+{
+    auto                  reference = WDFilter::create(type, order);
+    WDFRCFixedPoint<Word> engine(type, order);
+    reference->prepare(settings.sampleRate);
+    engine.prepare(settings.sampleRate);
+    reference->setCutoff(cutoff);
+    engine.setCutoff(cutoff);
+
+    EngineResult result;
+    result.headroomBits = engine.getHeadroomBits();
+    result.hash         = 14695981039346656037ull;
+
+    const auto numSamples = static_cast<int64_t>(settings.seconds * settings.sampleRate);
+    const auto settle     = static_cast<int64_t>(0.1 * settings.sampleRate); // skip the start transient
+    uint32_t   state      = 0x12345678u;
+    double     signal = 0.0, noise = 0.0;
+    for (int64_t n = 0; n < numSamples; ++n)
+    {
+        state = state * 1664525u + 1013904223u;
+
+        // Top bits of the LCG as a Q31 word at a quarter of full scale, then truncated to the word size
+        const auto q31   = static_cast<int32_t>(state) / 4;
+        const Word input = static_cast<Word>(q31 / (int32_t{1} << (32 - 8 * static_cast<int>(sizeof(Word)))));
+
+        const Word   output = engine.processSampleFixed(input);
+        const double ideal  = reference->processSample(wdf_core::fromFixedPoint(input));
+        hashWord(result.hash, output);
+
+        if (n >= settle)
+        {
+            const double error = wdf_core::fromFixedPoint(output) - ideal;
+            signal += ideal * ideal;
+            noise += error * error;
+        }
+    }
+
+    result.snr = noise > 0.0 ? 10.0 * std::log10(signal / noise) : 300.0;
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    AnalyzerSettings settings;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--cutoffs" && i + 1 < argc)
+        {
+            settings.cutoffs.clear();
+            std::stringstream list(argv[++i]);
+            std::string       item;
+            while (std::getline(list, item, ','))
+                settings.cutoffs.push_back(std::stod(item));
+        }
+        else if (arg == "--fs" && i + 1 < argc)
+            settings.sampleRate = std::stod(argv[++i]);
+        else if (arg == "--seconds" && i + 1 < argc)
+            settings.seconds = std::max(0.2, std::stod(argv[++i]));
+        else if (arg == "--min-snr-q31" && i + 1 < argc)
+            settings.minSnrQ31 = std::stod(argv[++i]);
+        else if (arg == "--min-snr-q15" && i + 1 < argc)
+            settings.minSnrQ15 = std::stod(argv[++i]);
+        else if (arg == "--out" && i + 1 < argc)
+            settings.outputFile = argv[++i];
+        else if (arg == "--help")
+        {
+            std::cout << "Usage: FixedPointAnalyzer [options]" << std::endl
+                      << "Options:" << std::endl
+                      << "  --cutoffs <list>      Cutoff frequencies in Hz" << std::endl
+                      << "                        (default: 50,200,1000,5000,15000)" << std::endl
+                      << "  --fs <value>          Sample rate in Hz (default: 48000)" << std::endl
+                      << "  --seconds <value>     Length of the noise input (default: 2)" << std::endl
+                      << "  --min-snr-q31 <dB>    Fail below this Q31 SNR (default: 120)" << std::endl
+                      << "  --min-snr-q15 <dB>    Fail below this Q15 SNR (default: 50)" << std::endl
+                      << "  --out <file>          CSV output file (default: ./fixed_point_snr.csv)" << std::endl
+                      << "  --help                Show this help message" << std::endl;
+            return 0;
+        }
+    }
+
+    std::ofstream file(settings.outputFile);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open file for writing: " << settings.outputFile << std::endl;
+        return 1;
+    }
+    file << "type,order,cutoff_hz,headroom_bits_q31,snr_q31_db,hash_q31,headroom_bits_q15,snr_q15_db,hash_q15\n";
+
+    std::cout << std::left << std::setw(10) << "Filter" << std::right << std::setw(10) << "Cutoff" << std::setw(12)
+              << "Q31 SNR" << std::setw(20) << "Q31 hash" << std::setw(12) << "Q15 SNR" << std::setw(20) << "Q15 hash"
+              << std::endl;
+
+    bool passed = true;
+    for (auto type : {WDFilter::Type::LowPass, WDFilter::Type::HighPass})
+    {
+        for (auto order : {WDFilter::Order::First, WDFilter::Order::Second})
+        {
+            const std::string typeName  = type == WDFilter::Type::LowPass ? "LowPass" : "HighPass";
+            const std::string shortName = type == WDFilter::Type::LowPass ? "LP" : "HP";
+            const int         orderName = order == WDFilter::Order::First ? 1 : 2;
+
+            for (double cutoff : settings.cutoffs)
+            {
+                const auto q31 = analyzeEngine<int32_t>(type, order, cutoff, settings);
+                const auto q15 = analyzeEngine<int16_t>(type, order, cutoff, settings);
+                passed         = passed && q31.snr >= settings.minSnrQ31 && q15.snr >= settings.minSnrQ15;
+
+                std::cout << std::left << std::setw(10) << (shortName + std::to_string(orderName))
+                          << std::right << std::fixed << std::setprecision(1) << std::setw(10) << cutoff
+                          << std::setw(12) << q31.snr << std::hex << std::setw(20) << q31.hash << std::dec
+                          << std::setw(12) << q15.snr << std::hex << std::setw(20) << q15.hash << std::dec
+                          << std::defaultfloat << std::endl;
+
+                file << typeName << "," << orderName << "," << cutoff << "," << q31.headroomBits << "," << q31.snr
+                     << "," << std::hex << q31.hash << std::dec << "," << q15.headroomBits << "," << q15.snr << ","
+                     << std::hex << q15.hash << std::dec << "\n";
+            }
+        }
+    }
+
+    std::cout << std::endl << "Results written to " << settings.outputFile.string() << std::endl;
+    if (!passed)
+    {
+        std::cerr << "SNR below the minimum (Q31 " << settings.minSnrQ31 << " dB, Q15 " << settings.minSnrQ15
+                  << " dB)" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "FrequencyResponse.h"
+
+#include <juce_dsp/juce_dsp.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace utils
+{
+
+    std::tuple<std::vector<double>, std::vector<double>, std::vector<double>>
+    calculateFrequencyResponse(WDFilter& filter, double sampleRate, int fftOrder)
+    {
+        const int      fftSize = 1 << fftOrder;
+        juce::dsp::FFT fft(fftOrder);
+
+        // Create buffer for FFT (2x size for complex output)
+        std::vector<float> fftData(static_cast<size_t>(2 * fftSize), 0.0f);
+
+        // Generate contiguous impulse response in the first half
+        fftData[0] = 1.0f; // impulse
+        for (int n = 0; n < fftSize; ++n)
+            fftData[n] = filter.processSample(fftData[n]);
+
+        // Perform FFT (with scaling)
+        fft.performRealOnlyForwardTransform(fftData.data(), true);
+
+        const int           numBins = fftSize / 2;
+        std::vector<double> freq(numBins), magDb(numBins), phaseDeg(numBins);
+
+        // Find maximum magnitude for normalization
+        double maxMag = 0.0;
+        for (int k = 0; k < numBins; ++k)
+            maxMag = std::max(maxMag, static_cast<double>(std::hypot(fftData[2 * k], fftData[2 * k + 1])));
+
+        // Calculate frequency response with phase unwrapping
+        double       prev    = 0.0;   // unwrap helper
+        const double epsilon = 1e-10; // Small value to prevent log(0)
+        for (int k = 0; k < numBins; ++k)
+        {
+            const float re = fftData[2 * k];
+            const float im = fftData[2 * k + 1];
+
+            const double mag = std::hypot(re, im);
+            double       ph  = std::atan2(im, re); // rad
+
+            // Unwrap phase to ensure continuity
+            double delta = ph - prev;
+            if (delta > M_PI)
+                ph -= 2 * M_PI;
+            else if (delta < -M_PI)
+                ph += 2 * M_PI;
+            prev = ph;
+
+            freq[k]     = k * sampleRate / fftSize;
+            magDb[k]    = 20.0 * std::log10((mag + epsilon) / maxMag);
+            phaseDeg[k] = ph * 180.0 / M_PI;
+        }
+
+        return {freq, magDb, phaseDeg};
+    }
+
+} // namespace utils
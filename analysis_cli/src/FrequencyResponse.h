@@ -0,0 +1,23 @@
+#pragma once
+
+#include <WDFilters/WDFilter.h>
+
+#include <tuple>
+#include <vector>
+
+namespace utils
+{
+
+    /**
+     * @brief Calculate the frequency response of a filter from its impulse response
+     *
+     * Magnitudes are normalized to the peak of the response; phases are unwrapped.
+     * @param filter Filter to analyze, already prepared and configured
+     * @param sampleRate Sample rate in Hz
+     * @param fftOrder FFT order (power of 2)
+     * @return Tuple containing frequencies, magnitudes (in dB), and phases (in degrees)
+     */
+    std::tuple<std::vector<double>, std::vector<double>, std::vector<double>>
+    calculateFrequencyResponse(WDFilter& filter, double sampleRate, int fftOrder);
+
+} // namespace utils
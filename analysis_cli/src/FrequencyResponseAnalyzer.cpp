@@ -1,4 +1,3 @@
-#include <juce_dsp/juce_dsp.h>
 #include <WDFilters/BandPassFilter.h>
 #include <WDFilters/HighPassFilter.h>
 #include <WDFilters/LowPassFilter.h>
@@ -8,77 +7,83 @@
 #include <complex>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "FrequencyResponse.h"
 #include "Utils.h"
+#include "WorkStealingPool.h"
 
 /**
- * @brief Calculate the frequency response of a filter
- * @param filter Pointer to the filter to analyze
- * @param sampleRate Sample rate in Hz
- * @param fftOrder FFT order (power of 2)
- * @return Tuple containing frequencies, magnitudes (in dB), and phases (in degrees)
+ * @brief Write a frequency response in the requested format(s)
+ * @param outputDir Output directory
+ * @param filename CSV filename; the .npy file uses the same stem
+ * @param frequencies Vector of frequency bins in Hz
+ * @param magnitudes Vector of magnitude values in dB
+ * @param phases Vector of phase values in degrees
+ * @param format Formats to write
+ * @param logMutex Serialises the progress messages of concurrent writes
  */
-static std::tuple<std::vector<double>, std::vector<double>, std::vector<double>>
-calculateFrequencyResponse(std::unique_ptr<WDFilter>& filter, double sampleRate, int fftOrder)
+static void writeResponse(const fs::path&            outputDir,
+                          const std::string&         filename,
+                          const std::vector<double>& frequencies,
+                          const std::vector<double>& magnitudes,
+                          const std::vector<double>& phases,
+                          utils::OutputFormat        format,
+                          std::mutex&                logMutex)
 {
-    const int      fftSize = 1 << fftOrder;
-    juce::dsp::FFT fft(fftOrder);
-
-    // Create buffer for FFT (2x size for complex output)
-    std::vector<float> fftData(static_cast<size_t>(2 * fftSize), 0.0f);
-
-    // Generate contiguous impulse response in the first half
-    fftData[0] = 1.0f; // impulse
-    for (int n = 0; n < fftSize; ++n)
-        fftData[n] = filter->processSample(fftData[n]);
-
-    // Perform FFT (with scaling)
-    fft.performRealOnlyForwardTransform(fftData.data(), true);
-
-    const int           numBins = fftSize / 2;
-    std::vector<double> freq(numBins), magDb(numBins), phaseDeg(numBins);
-
-    // Find maximum magnitude for normalization
-    double maxMag = 0.0;
-    for (int k = 0; k < numBins; ++k)
-        maxMag = std::max(maxMag, static_cast<double>(std::hypot(fftData[2 * k], fftData[2 * k + 1])));
-
-    // Calculate frequency response with phase unwrapping
-    double       prev    = 0.0;   // unwrap helper
-    const double epsilon = 1e-10; // Small value to prevent log(0)
-    for (int k = 0; k < numBins; ++k)
+    if (format != utils::OutputFormat::Npy)
     {
-        const float re = fftData[2 * k];
-        const float im = fftData[2 * k + 1];
-
-        const double mag = std::hypot(re, im);
-        double       ph  = std::atan2(im, re); // rad
-
-        // Unwrap phase to ensure continuity
-        double delta = ph - prev;
-        if (delta > M_PI)
-            ph -= 2 * M_PI;
-        else if (delta < -M_PI)
-            ph += 2 * M_PI;
-        prev = ph;
-
-        freq[k]     = k * sampleRate / fftSize;
-        magDb[k]    = 20.0 * std::log10((mag + epsilon) / maxMag);
-        phaseDeg[k] = ph * 180.0 / M_PI;
+        utils::writeCSV(outputDir / filename, frequencies, magnitudes, phases);
+        std::lock_guard<std::mutex> lock(logMutex);
+        std::cout << "Generated " << filename << std::endl;
     }
 
-    return {freq, magDb, phaseDeg};
+    if (format != utils::OutputFormat::CSV)
+    {
+        const std::string npyFilename = fs::path(filename).replace_extension(".npy").string();
+        utils::writeNpy(outputDir / npyFilename, frequencies, magnitudes, phases);
+        std::lock_guard<std::mutex> lock(logMutex);
+        std::cout << "Generated " << npyFilename << std::endl;
+    }
 }
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
+int main(int argc, char* argv[])
 {
     // Define constants
     constexpr double sampleRate = 48000.0;
     constexpr double cutoffFreq = 1000.0;
     constexpr int    fftOrder   = 14; // 16384-point FFT
 
+    utils::OutputFormat format     = utils::OutputFormat::CSV;
+    int                 numThreads = 0;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--format" && i + 1 < argc)
+        {
+            if (!utils::parseOutputFormat(argv[++i], format))
+            {
+                std::cerr << "Unknown output format: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+            numThreads = std::stoi(argv[++i]);
+        else if (arg == "--help")
+        {
+            std::cout << "Usage: FrequencyResponseAnalyzer [options]" << std::endl
+                      << "Options:" << std::endl
+                      << "  --format <csv|npy|both> Output file format (default: csv)" << std::endl
+                      << "  --threads <n>           Worker threads (default: hardware concurrency)" << std::endl
+                      << "  --help                  Show this help message" << std::endl;
+            return 0;
+        }
+    }
+
     // Create output directory
     fs::path outputDir = fs::current_path() / "frequency_responses";
     if (!utils::createDirectory(outputDir))
@@ -87,77 +92,42 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
         return 1;
     }
 
-    std::cout << "Generating frequency response CSVs for all filter types..." << std::endl;
+    std::cout << "Generating frequency responses for all filter types..." << std::endl;
     std::cout << "Output directory: " << outputDir.string() << std::endl;
 
-    // Generate responses for low pass filters (1st and 2nd order)
+    // Each response is one task; the filters and FFTs are independent, so they all run at once
+    struct ResponseJob
     {
-        auto filter = WDFilter::create(WDFilter::Type::LowPass, WDFilter::Order::First);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-
-        auto [frequencies, magnitudes, phases] = calculateFrequencyResponse(filter, sampleRate, fftOrder);
-        std::string filename                   = utils::generateFilename("LowPass", 1, cutoffFreq);
-        utils::writeCSV(outputDir / filename, frequencies, magnitudes, phases);
-        std::cout << "Generated " << filename << std::endl;
-    }
-
+        WDFilter::Type  type;
+        WDFilter::Order order;
+        const char*     typeName;
+        int             orderNumber;
+    };
+
+    const ResponseJob jobs[] = {
+        {WDFilter::Type::LowPass, WDFilter::Order::First, "LowPass", 1},
+        {WDFilter::Type::LowPass, WDFilter::Order::Second, "LowPass", 2},
+        {WDFilter::Type::HighPass, WDFilter::Order::First, "HighPass", 1},
+        {WDFilter::Type::HighPass, WDFilter::Order::Second, "HighPass", 2},
+        {WDFilter::Type::BandPass, WDFilter::Order::First, "BandPass", 1},
+        {WDFilter::Type::BandPass, WDFilter::Order::Second, "BandPass", 2},
+    };
+
+    utils::WorkStealingPool pool(numThreads);
+    std::mutex              logMutex;
+    for (const auto& job : jobs)
     {
-        auto filter = WDFilter::create(WDFilter::Type::LowPass, WDFilter::Order::Second);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-
-        auto [frequencies, magnitudes, phases] = calculateFrequencyResponse(filter, sampleRate, fftOrder);
-        std::string filename                   = utils::generateFilename("LowPass", 2, cutoffFreq);
-        utils::writeCSV(outputDir / filename, frequencies, magnitudes, phases);
-        std::cout << "Generated " << filename << std::endl;
-    }
-
-    // Generate responses for high pass filters (1st and 2nd order)
-    {
-        auto filter = WDFilter::create(WDFilter::Type::HighPass, WDFilter::Order::First);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-
-        auto [frequencies, magnitudes, phases] = calculateFrequencyResponse(filter, sampleRate, fftOrder);
-        std::string filename                   = utils::generateFilename("HighPass", 1, cutoffFreq);
-        utils::writeCSV(outputDir / filename, frequencies, magnitudes, phases);
-        std::cout << "Generated " << filename << std::endl;
-    }
-
-    {
-        auto filter = WDFilter::create(WDFilter::Type::HighPass, WDFilter::Order::Second);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-
-        auto [frequencies, magnitudes, phases] = calculateFrequencyResponse(filter, sampleRate, fftOrder);
-        std::string filename                   = utils::generateFilename("HighPass", 2, cutoffFreq);
-        utils::writeCSV(outputDir / filename, frequencies, magnitudes, phases);
-        std::cout << "Generated " << filename << std::endl;
-    }
-
-    // Generate responses for band pass filters (1st and 2nd order)
-    {
-        auto filter = WDFilter::create(WDFilter::Type::BandPass, WDFilter::Order::First);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-
-        auto [frequencies, magnitudes, phases] = calculateFrequencyResponse(filter, sampleRate, fftOrder);
-        std::string filename                   = utils::generateFilename("BandPass", 1, cutoffFreq);
-        utils::writeCSV(outputDir / filename, frequencies, magnitudes, phases);
-        std::cout << "Generated " << filename << std::endl;
-    }
-
-    {
-        auto filter = WDFilter::create(WDFilter::Type::BandPass, WDFilter::Order::Second);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-
-        auto [frequencies, magnitudes, phases] = calculateFrequencyResponse(filter, sampleRate, fftOrder);
-        std::string filename                   = utils::generateFilename("BandPass", 2, cutoffFreq);
-        utils::writeCSV(outputDir / filename, frequencies, magnitudes, phases);
-        std::cout << "Generated " << filename << std::endl;
+        pool.submit([&](int) {
+            auto filter = WDFilter::create(job.type, job.order);
+            filter->prepare(sampleRate);
+            filter->setCutoff(cutoffFreq);
+
+            auto [frequencies, magnitudes, phases] = utils::calculateFrequencyResponse(*filter, sampleRate, fftOrder);
+            std::string filename                   = utils::generateFilename(job.typeName, job.orderNumber, cutoffFreq);
+            writeResponse(outputDir, filename, frequencies, magnitudes, phases, format, logMutex);
+        });
     }
+    pool.wait();
 
     std::cout << "Frequency response analysis complete." << std::endl;
 
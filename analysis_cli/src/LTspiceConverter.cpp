@@ -0,0 +1,116 @@
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "LTspiceParser.h"
+#include "Utils.h"
+#include "WorkStealingPool.h"
+
+/**
+ * @brief Convert one LTspice export or .raw file into a frequency response CSV
+ * @param inputPath LTspice .txt export or .raw file
+ * @param outputPath Destination CSV file
+ * @param traceName Preferred trace; the first voltage trace is used if it does not exist
+ * @param usedTrace Receives the name of the converted trace
+ * @return True if the file was converted successfully
+ */
+static bool convertFile(const fs::path&    inputPath,
+                        const fs::path&    outputPath,
+                        const std::string& traceName,
+                        std::string&       usedTrace)
+{
+    utils::LTspiceData data;
+    if (!utils::readLTspice(inputPath, data))
+        return false;
+
+    const int trace = data.findTrace(traceName) >= 0 ? data.findTrace(traceName) : data.findTrace("");
+    if (trace < 0)
+        return false;
+    usedTrace = data.traceNames[static_cast<size_t>(trace)];
+
+    std::vector<double> frequencies, magnitudes, phases;
+    if (!utils::toFrequencyResponse(data, usedTrace, frequencies, magnitudes, phases))
+        return false;
+
+    return utils::writeCSV(outputPath, frequencies, magnitudes, phases);
+}
+
+int main(int argc, char* argv[])
+{
+    fs::path              outputDir  = fs::current_path() / "frequency_responses";
+    std::string           traceName  = "V(n003)";
+    int                   numThreads = 0;
+    std::vector<fs::path> inputs;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-o" || arg == "--output") && i + 1 < argc)
+            outputDir = argv[++i];
+        else if ((arg == "-v" || arg == "--voltage-column") && i + 1 < argc)
+            traceName = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc)
+            numThreads = std::stoi(argv[++i]);
+        else if (arg == "--help")
+        {
+            std::cout << "Usage: LTspiceConverter [options] <file.txt|file.raw>..." << std::endl
+                      << "Options:" << std::endl
+                      << "  -o, --output <dir>          Output directory (default: ./frequency_responses)" << std::endl
+                      << "  -v, --voltage-column <name> Trace to convert (default: V(n003), falling back to the"
+                      << std::endl
+                      << "                              first voltage trace)" << std::endl
+                      << "  --threads <n>               Worker threads (default: hardware concurrency)" << std::endl
+                      << "  --help                      Show this help message" << std::endl;
+            return 0;
+        }
+        else
+            inputs.emplace_back(arg);
+    }
+
+    if (inputs.empty())
+    {
+        std::cerr << "No input files given (see --help)" << std::endl;
+        return 1;
+    }
+
+    if (!utils::createDirectory(outputDir))
+    {
+        std::cerr << "Failed to create output directory" << std::endl;
+        return 1;
+    }
+
+    std::mutex       logMutex;
+    std::atomic<int> numFailed{0};
+
+    utils::WorkStealingPool pool(numThreads);
+    for (const auto& input : inputs)
+    {
+        // input refers into inputs, which outlives the tasks, so it is captured by reference like the rest
+        pool.submit([&](int) {
+            // Same naming as analysis/preprocess_ltspice.py: ltspice_<stem>.csv
+            const fs::path output = outputDir / ("ltspice_" + input.stem().string() + ".csv");
+
+            std::string usedTrace;
+            const bool  ok = convertFile(input, output, traceName, usedTrace);
+
+            std::lock_guard<std::mutex> lock(logMutex);
+            if (ok)
+                std::cout << "Converted " << input.filename().string() << " (" << usedTrace << ") -> "
+                          << output.filename().string() << std::endl;
+            else
+            {
+                ++numFailed;
+                std::cerr << "Failed to convert " << input.string() << std::endl;
+            }
+        });
+    }
+    pool.wait();
+
+    std::cout << "Successfully processed " << (static_cast<int>(inputs.size()) - numFailed.load()) << " out of "
+              << inputs.size() << " files" << std::endl;
+
+    return numFailed.load() == 0 ? 0 : 1;
+}
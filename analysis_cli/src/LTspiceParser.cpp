@@ -0,0 +1,523 @@
+#include "LTspiceParser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "MappedFile.h"
+
+namespace utils
+{
+
+    namespace
+    {
+        /**
+         * @brief Parses a floating-point number and advances the cursor past it
+         *
+         * Uses std::from_chars where the standard library implements it for floating point.
+         * Elsewhere (e.g. older libc++) it falls back to strtod on a NUL-terminated copy of the
+         * token, since the mapped file is not terminated.
+         */
+        bool parseNumber(const char*& cursor, const char* end, double& value)
+        {
+            while (cursor < end && (*cursor == ' ' || *cursor == '\t'))
+                ++cursor;
+            if (cursor < end && *cursor == '+') // from_chars rejects an explicit plus sign
+                ++cursor;
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            const auto result = std::from_chars(cursor, end, value);
+            if (result.ec != std::errc())
+                return false;
+            cursor = result.ptr;
+            return true;
+#else
+            char   token[64];
+            size_t length = 0;
+            while (cursor + length < end && length < sizeof(token) - 1 &&
+                   (std::isdigit(static_cast<unsigned char>(cursor[length])) ||
+                    std::strchr("+-.eE", cursor[length]) != nullptr) &&
+                   cursor[length] != '\0')
+            {
+                token[length] = cursor[length];
+                ++length;
+            }
+            token[length] = '\0';
+
+            char* parsed = nullptr;
+            value        = std::strtod(token, &parsed);
+            if (parsed == token)
+                return false;
+            cursor += parsed - token;
+            return true;
+#endif
+        }
+
+        void skipWhitespace(const char*& cursor, const char* end)
+        {
+            while (cursor < end && std::isspace(static_cast<unsigned char>(*cursor)))
+                ++cursor;
+        }
+
+        bool startsWith(const std::string& text, const char* prefix)
+        {
+            return text.compare(0, std::strlen(prefix), prefix) == 0;
+        }
+
+        bool equalsIgnoreCase(const std::string& a, const std::string& b)
+        {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                       return std::tolower(static_cast<unsigned char>(x)) ==
+                              std::tolower(static_cast<unsigned char>(y));
+                   });
+        }
+
+        double readDouble(const unsigned char* bytes)
+        {
+            uint64_t bits = 0;
+            for (int i = 0; i < 8; ++i)
+                bits |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        double readFloat(const unsigned char* bytes)
+        {
+            uint32_t bits = 0;
+            for (int i = 0; i < 4; ++i)
+                bits |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return static_cast<double>(value);
+        }
+
+        /**
+         * @brief Parses one value column of a plot export line
+         * @return True if the field matched the format
+         */
+        bool parsePlotField(
+            const char*& cursor, const char* end, LTspiceData::Format format, double& first, double& second)
+        {
+            switch (format)
+            {
+            case LTspiceData::Format::Polar:
+                // (<magnitude>dB,<phase>°) with the degree sign in Latin-1 or UTF-8
+                while (cursor < end && (*cursor == ' ' || *cursor == '\t'))
+                    ++cursor;
+                if (cursor == end || *cursor != '(')
+                    return false;
+                ++cursor;
+                if (!parseNumber(cursor, end, first))
+                    return false;
+                while (cursor < end && *cursor != ',')
+                    ++cursor;
+                if (cursor == end)
+                    return false;
+                ++cursor;
+                if (!parseNumber(cursor, end, second))
+                    return false;
+                while (cursor < end && *cursor != ')')
+                    ++cursor;
+                if (cursor == end)
+                    return false;
+                ++cursor;
+                return true;
+            case LTspiceData::Format::Cartesian:
+                if (!parseNumber(cursor, end, first) || cursor == end || *cursor != ',')
+                    return false;
+                ++cursor;
+                return parseNumber(cursor, end, second);
+            case LTspiceData::Format::Real:
+            default:
+                return parseNumber(cursor, end, first);
+            }
+        }
+    } // namespace
+
+    int LTspiceData::findTrace(const std::string& name) const
+    {
+        for (size_t i = 0; i < traceNames.size(); ++i)
+        {
+            const bool isVoltage = traceNames[i].size() > 1 && (traceNames[i][0] == 'V' || traceNames[i][0] == 'v') &&
+                                   traceNames[i][1] == '(';
+            if (name.empty() ? isVoltage : equalsIgnoreCase(traceNames[i], name))
+                return static_cast<int>(i);
+        }
+
+        return name.empty() && !traceNames.empty() ? 0 : -1;
+    }
+
+    bool readLTspicePlot(const fs::path& filePath, LTspiceData& data)
+    {
+        MappedFile file;
+        if (!file.open(filePath))
+            return false;
+
+        data = LTspiceData();
+
+        const char* cursor = reinterpret_cast<const char*>(file.data());
+        const char* end    = cursor + file.size();
+
+        // Header: axis name followed by one name per trace, tab separated
+        const char* headerEnd = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        if (headerEnd == nullptr)
+            headerEnd = end;
+
+        std::string header(cursor, headerEnd);
+        if (!header.empty() && header.back() == '\r')
+            header.pop_back();
+
+        size_t start = 0;
+        while (start <= header.size())
+        {
+            const size_t tab  = std::min(header.find('\t', start), header.size());
+            std::string  name = header.substr(start, tab - start);
+            if (data.axisName.empty())
+                data.axisName = name;
+            else
+                data.traceNames.push_back(name);
+            start = tab + 1;
+        }
+
+        if (data.traceNames.empty())
+        {
+            std::cerr << "Error: No traces found in " << filePath << std::endl;
+            return false;
+        }
+
+        const size_t numTraces = data.traceNames.size();
+        data.values.resize(numTraces);
+
+        bool   formatKnown = false;
+        size_t lineNumber  = 1;
+        cursor             = headerEnd < end ? headerEnd + 1 : end;
+        while (cursor < end)
+        {
+            ++lineNumber;
+            const char* line = cursor;
+            const char* eol  = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+            if (eol == nullptr)
+                eol = end;
+            cursor = eol < end ? eol + 1 : end;
+
+            const char* stop = eol;
+            if (stop > line && stop[-1] == '\r')
+                --stop;
+            if (stop == line)
+                continue;
+
+            // Stepped simulations separate their runs with "Step Information" lines; keep the first run
+            if (static_cast<size_t>(stop - line) >= 4 && std::memcmp(line, "Step", 4) == 0)
+            {
+                if (!data.axis.empty())
+                    break;
+                continue;
+            }
+
+            const char* field = line;
+            double      axisValue;
+            if (!parseNumber(field, stop, axisValue))
+            {
+                std::cerr << "Error: Malformed line " << lineNumber << " in " << filePath << std::endl;
+                return false;
+            }
+
+            for (size_t trace = 0; trace < numTraces; ++trace)
+            {
+                while (field < stop && (*field == ' ' || *field == '\t'))
+                    ++field;
+
+                if (!formatKnown)
+                {
+                    const char* fieldEnd = field;
+                    while (fieldEnd < stop && *fieldEnd != '\t')
+                        ++fieldEnd;
+
+                    if (field < stop && *field == '(')
+                        data.format = LTspiceData::Format::Polar;
+                    else if (std::find(field, fieldEnd, ',') != fieldEnd)
+                        data.format = LTspiceData::Format::Cartesian;
+                    else
+                        data.format = LTspiceData::Format::Real;
+
+                    if (data.format != LTspiceData::Format::Real)
+                        data.imagOrPhase.resize(numTraces);
+                    formatKnown = true;
+                }
+
+                double first = 0.0, second = 0.0;
+                if (!parsePlotField(field, stop, data.format, first, second))
+                {
+                    std::cerr << "Error: Malformed line " << lineNumber << " in " << filePath << std::endl;
+                    return false;
+                }
+
+                data.values[trace].push_back(first);
+                if (data.format != LTspiceData::Format::Real)
+                    data.imagOrPhase[trace].push_back(second);
+            }
+
+            data.axis.push_back(axisValue);
+        }
+
+        if (data.axis.empty())
+        {
+            std::cerr << "Error: No data found in " << filePath << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool readLTspiceRaw(const fs::path& filePath, LTspiceData& data)
+    {
+        MappedFile file;
+        if (!file.open(filePath))
+            return false;
+
+        data = LTspiceData();
+
+        const unsigned char* bytes = file.data();
+        const uint64_t       size  = file.size();
+
+        // LTspice XVII and later write the header in UTF-16LE; it only ever holds ASCII characters
+        uint64_t position = size >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE ? 2 : 0;
+        const bool     utf16    = size >= position + 2 && bytes[position + 1] == 0;
+        const uint64_t charSize = utf16 ? 2 : 1;
+
+        std::string              flags;
+        std::vector<std::string> names;
+        uint64_t                 numVariables = 0;
+        uint64_t                 numPoints    = 0;
+        bool                     inVariables  = false;
+        bool                     foundData    = false;
+        bool                     binary       = false;
+
+        std::string line;
+        while (position + charSize <= size)
+        {
+            const char c = static_cast<char>(bytes[position]);
+            position += charSize;
+
+            if (c != '\n')
+            {
+                if (c != '\r')
+                    line += c;
+                continue;
+            }
+
+            if (line == "Binary:" || line == "Values:")
+            {
+                binary    = line == "Binary:";
+                foundData = true;
+                break;
+            }
+
+            if (inVariables && !line.empty() && (line[0] == '\t' || line[0] == ' '))
+            {
+                // "\t<index>\t<name>\t<type>"
+                const size_t indexStart = line.find_first_not_of(" \t");
+                const size_t nameStart  = line.find_first_not_of(" \t", line.find_first_of(" \t", indexStart));
+                const size_t nameEnd    = line.find_first_of(" \t", nameStart);
+                if (nameStart != std::string::npos)
+                    names.push_back(line.substr(nameStart, nameEnd - nameStart));
+            }
+            else
+            {
+                inVariables = false;
+                if (startsWith(line, "Flags:"))
+                    flags = line.substr(6);
+                else if (startsWith(line, "No. Variables:"))
+                    numVariables = std::strtoull(line.c_str() + 14, nullptr, 10);
+                else if (startsWith(line, "No. Points:"))
+                    numPoints = std::strtoull(line.c_str() + 11, nullptr, 10);
+                else if (startsWith(line, "Variables:"))
+                    inVariables = true;
+            }
+
+            line.clear();
+        }
+
+        if (!foundData || numVariables < 2 || names.size() != numVariables)
+        {
+            std::cerr << "Error: " << filePath << " is not a valid LTspice .raw file." << std::endl;
+            return false;
+        }
+
+        const bool   isComplex  = flags.find("complex") != std::string::npos;
+        const bool   allDoubles = flags.find("double") != std::string::npos;
+        const bool   fastAccess = flags.find("fastaccess") != std::string::npos;
+        const size_t numTraces  = static_cast<size_t>(numVariables - 1);
+        const size_t points     = static_cast<size_t>(numPoints);
+
+        data.format   = isComplex ? LTspiceData::Format::Cartesian : LTspiceData::Format::Real;
+        data.axisName = names[0];
+        data.traceNames.assign(names.begin() + 1, names.end());
+        data.axis.resize(points);
+        data.values.assign(numTraces, std::vector<double>(points));
+        if (isComplex)
+            data.imagOrPhase.assign(numTraces, std::vector<double>(points));
+
+        if (binary)
+        {
+            // Complex plots store every variable as two doubles. Real plots store the axis as a
+            // double and the traces as floats unless the "double" flag is set.
+            const uint64_t axisBytes  = isComplex ? 16 : 8;
+            const uint64_t valueBytes = isComplex ? 16 : (allDoubles ? 8 : 4);
+            const uint64_t pointBytes = axisBytes + numTraces * valueBytes;
+            if (size - position < numPoints * pointBytes)
+            {
+                std::cerr << "Error: " << filePath << " is truncated." << std::endl;
+                return false;
+            }
+
+            const unsigned char* base = bytes + position;
+
+            // Points are stored one after another, or variable by variable with "fastaccess"
+            const uint64_t axisStride  = fastAccess ? axisBytes : pointBytes;
+            const uint64_t valueStride = fastAccess ? valueBytes : pointBytes;
+            auto           traceStart  = [&](size_t trace) {
+                return fastAccess ? base + numPoints * axisBytes + trace * numPoints * valueBytes
+                                  : base + axisBytes + trace * valueBytes;
+            };
+
+            // Transient analyses flag some time points by setting the sign bit
+            for (size_t n = 0; n < points; ++n)
+            {
+                const double axisValue = readDouble(base + n * axisStride);
+                data.axis[n]           = isComplex ? axisValue : std::abs(axisValue);
+            }
+
+            for (size_t trace = 0; trace < numTraces; ++trace)
+            {
+                const unsigned char* source = traceStart(trace);
+                std::vector<double>& first  = data.values[trace];
+
+                if (isComplex)
+                {
+                    std::vector<double>& second = data.imagOrPhase[trace];
+                    for (size_t n = 0; n < points; ++n)
+                    {
+                        first[n]  = readDouble(source + n * valueStride);
+                        second[n] = readDouble(source + n * valueStride + 8);
+                    }
+                }
+                else if (allDoubles)
+                {
+                    for (size_t n = 0; n < points; ++n)
+                        first[n] = readDouble(source + n * valueStride);
+                }
+                else
+                {
+                    for (size_t n = 0; n < points; ++n)
+                        first[n] = readFloat(source + n * valueStride);
+                }
+            }
+
+            return true;
+        }
+
+        // ASCII data: "<index>\t<axis>" followed by one "\t<value>" line per trace, complex values as "re,im"
+        std::string narrowed;
+        const char* cursor = reinterpret_cast<const char*>(bytes + position);
+        const char* end    = reinterpret_cast<const char*>(bytes + size);
+        if (utf16)
+        {
+            narrowed.reserve(static_cast<size_t>((size - position) / 2));
+            for (uint64_t i = position; i + 1 < size; i += 2)
+                narrowed += static_cast<char>(bytes[i]);
+            cursor = narrowed.data();
+            end    = cursor + narrowed.size();
+        }
+
+        auto parseValue = [&](double& first, double& second) {
+            skipWhitespace(cursor, end);
+            if (!parseNumber(cursor, end, first))
+                return false;
+            if (!isComplex)
+                return true;
+            if (cursor == end || *cursor != ',')
+                return false;
+            ++cursor;
+            return parseNumber(cursor, end, second);
+        };
+
+        for (size_t n = 0; n < points; ++n)
+        {
+            double index = 0.0, axisValue = 0.0, unused = 0.0;
+            skipWhitespace(cursor, end);
+            bool ok = parseNumber(cursor, end, index) && parseValue(axisValue, unused);
+
+            for (size_t trace = 0; ok && trace < numTraces; ++trace)
+            {
+                double second = 0.0;
+                ok            = parseValue(data.values[trace][n], second);
+                if (isComplex)
+                    data.imagOrPhase[trace][n] = second;
+            }
+
+            if (!ok)
+            {
+                std::cerr << "Error: Malformed data for point " << n << " in " << filePath << std::endl;
+                return false;
+            }
+
+            data.axis[n] = isComplex ? axisValue : std::abs(axisValue);
+        }
+
+        return true;
+    }
+
+    bool readLTspice(const fs::path& filePath, LTspiceData& data)
+    {
+        std::string extension = filePath.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+
+        return extension == ".raw" ? readLTspiceRaw(filePath, data) : readLTspicePlot(filePath, data);
+    }
+
+    bool toFrequencyResponse(const LTspiceData&   data,
+                             const std::string&   traceName,
+                             std::vector<double>& frequencies,
+                             std::vector<double>& magnitudes,
+                             std::vector<double>& phases)
+    {
+        const int trace = data.findTrace(traceName);
+        if (trace < 0 || data.format == LTspiceData::Format::Real)
+        {
+            std::cerr << "Error: No complex trace " << (traceName.empty() ? "V(...)" : traceName)
+                      << " in LTspice data." << std::endl;
+            return false;
+        }
+
+        const std::vector<double>& first  = data.values[static_cast<size_t>(trace)];
+        const std::vector<double>& second = data.imagOrPhase[static_cast<size_t>(trace)];
+
+        frequencies = data.axis;
+        if (data.format == LTspiceData::Format::Polar)
+        {
+            magnitudes = first;
+            phases     = second;
+            return true;
+        }
+
+        magnitudes.resize(first.size());
+        phases.resize(first.size());
+        for (size_t n = 0; n < first.size(); ++n)
+        {
+            magnitudes[n] = 20.0 * std::log10(std::hypot(first[n], second[n]));
+            phases[n]     = std::atan2(second[n], first[n]) * 180.0 / M_PI;
+        }
+
+        return true;
+    }
+
+} // namespace utils
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace utils
+{
+
+    /**
+     * @brief Traces loaded from an LTspice plot export or .raw file
+     *
+     * All traces share one axis (frequency for AC analyses, time for transient ones).
+     * Values are kept in the representation found in the file, so magnitudes and phases
+     * exported by LTspice pass through unchanged.
+     */
+    struct LTspiceData
+    {
+        enum class Format
+        {
+            Real,      // one real value per point (transient, DC sweeps)
+            Cartesian, // real and imaginary part per point
+            Polar      // magnitude in dB and phase in degrees per point
+        };
+
+        Format                           format = Format::Real;
+        std::string                      axisName;
+        std::vector<double>              axis;
+        std::vector<std::string>         traceNames;
+        std::vector<std::vector<double>> values;      // real part, or magnitude in dB for polar data
+        std::vector<std::vector<double>> imagOrPhase; // imaginary part or phase in degrees; empty for real data
+
+        /**
+         * @brief Finds a trace by name
+         * @param name Trace name as shown by LTspice, e.g. "V(n002)"; empty selects the first voltage trace
+         * @return Index into traceNames, or -1 if there is no such trace
+         */
+        int findTrace(const std::string& name) const;
+    };
+
+    /**
+     * @brief Reads a plot exported from the LTspice waveform viewer (File > Export data as text)
+     *
+     * Accepts polar "(xdB,y°)", cartesian "re,im" and real columns, Latin-1 or UTF-8 degree
+     * signs and CRLF line endings. For stepped simulations only the first step is read.
+     * @param filePath Path to the exported .txt file
+     * @param data Receives the traces
+     * @return True if the file was parsed successfully
+     */
+    bool readLTspicePlot(const fs::path& filePath, LTspiceData& data);
+
+    /**
+     * @brief Reads an LTspice .raw simulation output
+     *
+     * Handles binary and ASCII ("Values:") data, UTF-16 and ASCII headers, complex (AC) and
+     * real (transient) plots, and the "double" and "fastaccess" layouts.
+     * @param filePath Path to the .raw file
+     * @param data Receives the traces
+     * @return True if the file was parsed successfully
+     */
+    bool readLTspiceRaw(const fs::path& filePath, LTspiceData& data);
+
+    /**
+     * @brief Reads a plot export or .raw file, chosen by the file extension
+     * @param filePath Path to the .txt or .raw file
+     * @param data Receives the traces
+     * @return True if the file was parsed successfully
+     */
+    bool readLTspice(const fs::path& filePath, LTspiceData& data);
+
+    /**
+     * @brief Extracts a frequency response from an AC analysis
+     * @param data Traces of an AC analysis (cartesian or polar)
+     * @param traceName Trace to extract; empty selects the first voltage trace
+     * @param frequencies Receives the frequencies in Hz
+     * @param magnitudes Receives the magnitudes in dB
+     * @param phases Receives the phases in degrees
+     * @return True if the trace exists and holds complex data
+     */
+    bool toFrequencyResponse(const LTspiceData&   data,
+                             const std::string&   traceName,
+                             std::vector<double>& frequencies,
+                             std::vector<double>& magnitudes,
+                             std::vector<double>& phases);
+
+} // namespace utils
@@ -0,0 +1,123 @@
+#include "MappedFile.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utils
+{
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::open(const fs::path& filePath)
+    {
+        close();
+
+#ifdef _WIN32
+        fileHandle = CreateFileW(filePath.c_str(),
+                                 GENERIC_READ,
+                                 FILE_SHARE_READ,
+                                 nullptr,
+                                 OPEN_EXISTING,
+                                 FILE_FLAG_SEQUENTIAL_SCAN,
+                                 nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            fileHandle = nullptr;
+            std::cerr << "Error: Could not open file " << filePath << " for reading." << std::endl;
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            std::cerr << "Error: " << filePath << " is empty or unreadable." << std::endl;
+            close();
+            return false;
+        }
+
+        mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view =
+            mappingHandle != nullptr ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view == nullptr)
+        {
+            std::cerr << "Error: Could not map " << filePath << " into memory." << std::endl;
+            close();
+            return false;
+        }
+
+        mappedData = static_cast<const unsigned char*>(view);
+        mappedSize = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+        const int fd = ::open(filePath.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            std::cerr << "Error: Could not open file " << filePath << " for reading." << std::endl;
+            return false;
+        }
+
+        struct stat fileInfo;
+        if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size <= 0)
+        {
+            std::cerr << "Error: " << filePath << " is empty or unreadable." << std::endl;
+            ::close(fd);
+            return false;
+        }
+
+        // The mapping keeps its own reference to the file, so the descriptor can go right away
+        const size_t size = static_cast<size_t>(fileInfo.st_size);
+        void*        view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            std::cerr << "Error: Could not map " << filePath << " into memory." << std::endl;
+            return false;
+        }
+
+        // Readers walk the file front to back; let the kernel read ahead aggressively
+        madvise(view, size, MADV_SEQUENTIAL);
+
+        mappedData = static_cast<const unsigned char*>(view);
+        mappedSize = size;
+#endif
+
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+#ifdef _WIN32
+        if (mappedData != nullptr)
+            UnmapViewOfFile(mappedData);
+        if (mappingHandle != nullptr)
+            CloseHandle(mappingHandle);
+        if (fileHandle != nullptr)
+            CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle    = nullptr;
+#else
+        if (mappedData != nullptr)
+            munmap(const_cast<unsigned char*>(mappedData), static_cast<size_t>(mappedSize));
+#endif
+
+        mappedData = nullptr;
+        mappedSize = 0;
+    }
+
+} // namespace utils
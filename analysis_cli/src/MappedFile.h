@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace utils
+{
+
+    /**
+     * @brief Read-only memory mapping of a whole file
+     *
+     * Uses mmap on POSIX systems and a file mapping on Windows. The OS pages the contents in
+     * as they are touched, so large inputs cost address space rather than RAM.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Maps a file, unmapping any previously mapped one
+         * @param filePath Path to the file
+         * @return True if the file exists, is not empty and was mapped
+         */
+        bool open(const fs::path& filePath);
+
+        /**
+         * @brief Unmaps the file
+         */
+        void close();
+
+        bool                 isOpen() const { return mappedData != nullptr; }
+        const unsigned char* data() const { return mappedData; }
+        uint64_t             size() const { return mappedSize; }
+
+    private:
+        const unsigned char* mappedData = nullptr;
+        uint64_t             mappedSize = 0;
+
+#ifdef _WIN32
+        void* fileHandle    = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+
+} // namespace utils
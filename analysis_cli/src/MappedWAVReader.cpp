@@ -0,0 +1,239 @@
+#include "MappedWAVReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace utils
+{
+
+    namespace
+    {
+        // Source bytes converted per step of readFrames(); small enough to stay in L1/L2
+        // while every requested channel is extracted from them
+        constexpr size_t conversionBlockBytes = 32768;
+
+        template <typename IntType>
+        IntType readLE(const unsigned char* bytes)
+        {
+            IntType value = 0;
+            for (size_t i = 0; i < sizeof(IntType); ++i)
+                value |= static_cast<IntType>(static_cast<IntType>(bytes[i]) << (8 * i));
+            return value;
+        }
+
+        float decodePCM16(const unsigned char* bytes)
+        {
+            return static_cast<float>(static_cast<int16_t>(readLE<uint16_t>(bytes))) / 32768.0f;
+        }
+
+        float decodePCM24(const unsigned char* bytes)
+        {
+            // Place the 24 bits at the top of an int32 so the sign extends
+            const uint32_t raw = (static_cast<uint32_t>(bytes[0]) << 8) | (static_cast<uint32_t>(bytes[1]) << 16) |
+                                 (static_cast<uint32_t>(bytes[2]) << 24);
+            return static_cast<float>(static_cast<int32_t>(raw)) / 2147483648.0f;
+        }
+
+        float decodePCM32(const unsigned char* bytes)
+        {
+            return static_cast<float>(static_cast<int32_t>(readLE<uint32_t>(bytes))) / 2147483648.0f;
+        }
+
+        float decodeFloat32(const unsigned char* bytes)
+        {
+            const uint32_t bits = readLE<uint32_t>(bytes);
+            float          value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        float decodeFloat64(const unsigned char* bytes)
+        {
+            const uint64_t bits = readLE<uint64_t>(bytes);
+            double         value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return static_cast<float>(value);
+        }
+
+        /**
+         * @brief De-interleaves and converts one block of frames
+         *
+         * The decoder is a template parameter so each format gets its own tight loop.
+         */
+        template <float (*Decode)(const unsigned char*)>
+        void convertBlock(const unsigned char* frames,
+                          size_t               numFrames,
+                          size_t               bytesPerFrame,
+                          size_t               bytesPerSample,
+                          int                  numChannels,
+                          float* const*        destination,
+                          size_t               offset)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                if (destination[ch] == nullptr)
+                    continue;
+
+                const unsigned char* source = frames + static_cast<size_t>(ch) * bytesPerSample;
+                float*               out    = destination[ch] + offset;
+                for (size_t n = 0; n < numFrames; ++n)
+                    out[n] = Decode(source + n * bytesPerFrame);
+            }
+        }
+    } // namespace
+
+    MappedWAVReader::~MappedWAVReader()
+    {
+        close();
+    }
+
+    bool MappedWAVReader::open(const fs::path& filePath)
+    {
+        close();
+
+        if (!file.open(filePath))
+            return false;
+
+        mappedData = file.data();
+        mappedSize = file.size();
+
+        if (!parseHeader(filePath))
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void MappedWAVReader::close()
+    {
+        file.close();
+
+        mappedData    = nullptr;
+        mappedSize    = 0;
+        frameData     = nullptr;
+        numFrames     = 0;
+        bytesPerFrame = 0;
+    }
+
+    bool MappedWAVReader::parseHeader(const fs::path& filePath)
+    {
+        const unsigned char* bytes = mappedData;
+
+        const bool isRIFF = mappedSize >= 12 && std::memcmp(bytes, "RIFF", 4) == 0;
+        const bool isRF64 =
+            mappedSize >= 12 && (std::memcmp(bytes, "RF64", 4) == 0 || std::memcmp(bytes, "BW64", 4) == 0);
+        if ((!isRIFF && !isRF64) || std::memcmp(bytes + 8, "WAVE", 4) != 0)
+        {
+            std::cerr << "Error: " << filePath << " is not a RIFF/WAVE or RF64 file." << std::endl;
+            return false;
+        }
+
+        uint16_t formatTag = 0, channels = 0, bits = 0;
+        uint32_t rate       = 0;
+        bool     haveFormat = false;
+        uint64_t dataSize64 = 0;
+
+        // Walk the chunk list until the data chunk; everything except "ds64" and "fmt " is skipped
+        uint64_t position = 12;
+        while (position + 8 <= mappedSize)
+        {
+            const unsigned char* chunk     = bytes + position;
+            const uint64_t       body      = position + 8;
+            uint64_t             chunkSize = readLE<uint32_t>(chunk + 4);
+
+            if (std::memcmp(chunk, "ds64", 4) == 0)
+            {
+                // RF64 stores the real 64-bit data size here and 0xFFFFFFFF in the data chunk
+                if (chunkSize >= 24 && body + 24 <= mappedSize)
+                    dataSize64 = readLE<uint64_t>(bytes + body + 8);
+            }
+            else if (std::memcmp(chunk, "fmt ", 4) == 0)
+            {
+                if (chunkSize < 16 || body + chunkSize > mappedSize)
+                    break;
+
+                const unsigned char* fmt = bytes + body;
+                formatTag                = readLE<uint16_t>(fmt);
+                channels                 = readLE<uint16_t>(fmt + 2);
+                rate                     = readLE<uint32_t>(fmt + 4);
+                bits                     = readLE<uint16_t>(fmt + 14);
+
+                // WAVE_FORMAT_EXTENSIBLE stores the real format in the first two bytes of the sub-format GUID
+                if (formatTag == 0xFFFE && chunkSize >= 26)
+                    formatTag = readLE<uint16_t>(fmt + 24);
+
+                haveFormat = true;
+            }
+            else if (std::memcmp(chunk, "data", 4) == 0)
+            {
+                const bool supported = haveFormat && channels > 0 &&
+                                       ((formatTag == 1 && (bits == 16 || bits == 24 || bits == 32)) ||
+                                        (formatTag == 3 && (bits == 32 || bits == 64)));
+                if (!supported)
+                {
+                    std::cerr << "Error: Unsupported WAV format in " << filePath << std::endl;
+                    return false;
+                }
+
+                if (isRF64 && chunkSize == 0xFFFFFFFFu)
+                    chunkSize = dataSize64;
+
+                // Truncated recordings are read up to the end of the file
+                const uint64_t available = std::min(chunkSize, mappedSize - body);
+
+                numChannels   = channels;
+                bitsPerSample = bits;
+                floatingPoint = formatTag == 3;
+                sampleRate    = static_cast<double>(rate);
+                bytesPerFrame = static_cast<size_t>(bits / 8u) * channels;
+                frameData     = bytes + body;
+                numFrames     = available / bytesPerFrame;
+                return true;
+            }
+
+            // Chunks are word aligned
+            position = body + chunkSize + (chunkSize & 1u);
+        }
+
+        std::cerr << "Error: No audio data found in " << filePath << std::endl;
+        return false;
+    }
+
+    size_t MappedWAVReader::readFrames(uint64_t startFrame, size_t numFramesToRead, float* const* destination) const
+    {
+        if (!isOpen() || startFrame >= numFrames)
+            return 0;
+
+        const size_t total          = static_cast<size_t>(std::min<uint64_t>(numFramesToRead, numFrames - startFrame));
+        const size_t bytesPerSample = static_cast<size_t>(bitsPerSample / 8);
+        const size_t framesPerBlock = std::max<size_t>(1, conversionBlockBytes / bytesPerFrame);
+
+        for (size_t offset = 0; offset < total; offset += framesPerBlock)
+        {
+            const size_t         numInBlock = std::min(framesPerBlock, total - offset);
+            const unsigned char* frames     = getFrameData(startFrame + offset);
+
+            if (floatingPoint && bitsPerSample == 32)
+                convertBlock<decodeFloat32>(
+                    frames, numInBlock, bytesPerFrame, bytesPerSample, numChannels, destination, offset);
+            else if (floatingPoint)
+                convertBlock<decodeFloat64>(
+                    frames, numInBlock, bytesPerFrame, bytesPerSample, numChannels, destination, offset);
+            else if (bitsPerSample == 16)
+                convertBlock<decodePCM16>(
+                    frames, numInBlock, bytesPerFrame, bytesPerSample, numChannels, destination, offset);
+            else if (bitsPerSample == 24)
+                convertBlock<decodePCM24>(
+                    frames, numInBlock, bytesPerFrame, bytesPerSample, numChannels, destination, offset);
+            else
+                convertBlock<decodePCM32>(
+                    frames, numInBlock, bytesPerFrame, bytesPerSample, numChannels, destination, offset);
+        }
+
+        return total;
+    }
+
+} // namespace utils
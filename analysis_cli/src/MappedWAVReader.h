@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include "MappedFile.h"
+
+namespace utils
+{
+
+    /**
+     * @brief Memory-mapped WAV/RF64 reader
+     *
+     * The file is mapped read-only instead of being loaded, so multi-gigabyte recordings cost
+     * address space rather than RAM and the OS pages samples in as they are touched. The frames
+     * can be accessed in their stored format without a copy, or converted to float on demand
+     * for just the range that is requested.
+     *
+     * Supports 16/24/32-bit PCM and 32/64-bit IEEE float, including WAVE_FORMAT_EXTENSIBLE
+     * headers, in both RIFF and RF64 containers.
+     */
+    class MappedWAVReader
+    {
+    public:
+        MappedWAVReader() = default;
+        ~MappedWAVReader();
+
+        MappedWAVReader(const MappedWAVReader&)            = delete;
+        MappedWAVReader& operator=(const MappedWAVReader&) = delete;
+
+        /**
+         * @brief Maps a WAV file and parses its header
+         * @param filePath Path to the WAV file
+         * @return True if the file was mapped and holds a supported format
+         */
+        bool open(const fs::path& filePath);
+
+        /**
+         * @brief Unmaps the file
+         */
+        void close();
+
+        bool isOpen() const { return file.isOpen(); }
+
+        double   getSampleRate() const { return sampleRate; }
+        int      getNumChannels() const { return numChannels; }
+        int      getBitsPerSample() const { return bitsPerSample; }
+        bool     isFloatingPoint() const { return floatingPoint; }
+        uint64_t getNumFrames() const { return numFrames; }
+        size_t   getBytesPerFrame() const { return bytesPerFrame; }
+
+        /**
+         * @brief Gets the stored frames without conversion
+         * @param startFrame First frame of the view
+         * @return Pointer to the interleaved frame data; the view extends to getNumFrames()
+         */
+        const unsigned char* getFrameData(uint64_t startFrame = 0) const
+        {
+            return frameData + startFrame * bytesPerFrame;
+        }
+
+        /**
+         * @brief Converts a range of frames to de-interleaved float samples in [-1, 1]
+         *
+         * The range is converted in cache-sized blocks so the source bytes are only
+         * read from memory once, however many channels are extracted.
+         * @param startFrame First frame to convert
+         * @param numFramesToRead Number of frames to convert
+         * @param destination One pointer per channel; channels with a null pointer are skipped
+         * @return Number of frames converted (fewer than requested at the end of the file)
+         */
+        size_t readFrames(uint64_t startFrame, size_t numFramesToRead, float* const* destination) const;
+
+    private:
+        bool parseHeader(const fs::path& filePath);
+
+        MappedFile           file;
+        const unsigned char* mappedData    = nullptr;
+        uint64_t             mappedSize    = 0;
+        const unsigned char* frameData     = nullptr;
+        uint64_t             numFrames     = 0;
+        size_t               bytesPerFrame = 0;
+        double               sampleRate    = 0.0;
+        int                  numChannels   = 0;
+        int                  bitsPerSample = 0;
+        bool                 floatingPoint = false;
+    };
+
+} // namespace utils
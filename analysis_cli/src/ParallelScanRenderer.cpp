@@ -0,0 +1,165 @@
+#include "ParallelScanRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace utils
+{
+
+    namespace
+    {
+        // The zero-input response is dropped once every state is below this (-200 dB re full scale)
+        constexpr double settledLevel = 1.0e-10;
+
+        // Samples between the checks of the decaying state
+        constexpr size_t settleCheckInterval = 64;
+    } // namespace
+
+    ParallelScanRenderer::ParallelScanRenderer(WorkStealingPool&    workerPool,
+                                               const FilterFactory& createFilter,
+                                               size_t               samplesPerChunk)
+        : pool(workerPool)
+        , chunkSize(std::max<size_t>(1024, samplesPerChunk))
+    {
+        for (int i = 0; i < pool.getNumWorkers(); ++i)
+            filters.push_back(createFilter());
+
+        stateSize = static_cast<size_t>(std::max(0, filters.front()->getStateSize()));
+        carriedState.assign(stateSize, 0.0);
+        zeroState.assign(stateSize, 0.0);
+
+        // Column j of A is the state one sample of silence after the unit state e_j
+        WDFilter&           probe = *filters.front();
+        std::vector<double> state(stateSize);
+        transition.assign(stateSize * stateSize, 0.0);
+        for (size_t j = 0; j < stateSize; ++j)
+        {
+            std::fill(state.begin(), state.end(), 0.0);
+            state[j] = 1.0;
+            probe.setState(state.data());
+            probe.processSample(0.0);
+            probe.getState(state.data());
+
+            for (size_t i = 0; i < stateSize; ++i)
+                transition[i * stateSize + j] = state[i];
+        }
+
+        chunkTransition = power(chunkSize);
+    }
+
+    void ParallelScanRenderer::reset() { std::fill(carriedState.begin(), carriedState.end(), 0.0); }
+
+    void ParallelScanRenderer::process(float* samples, size_t numSamples)
+    {
+        if (numSamples == 0)
+            return;
+
+        if (stateSize == 0)
+        {
+            // Nothing to join the chunks with: filter sequentially
+            filters.front()->processBlock(samples, static_cast<int>(numSamples));
+            return;
+        }
+
+        const size_t numChunks = (numSamples + chunkSize - 1) / chunkSize;
+        finalStates.resize(numChunks * stateSize);
+        entryStates.resize(numChunks * stateSize);
+
+        // 1. Zero-state responses, in place
+        for (size_t k = 0; k < numChunks; ++k)
+        {
+            pool.submit([this, samples, numSamples, k](int workerIndex) {
+                WDFilter& filter = *filters[static_cast<size_t>(workerIndex)];
+                filter.setState(zeroState.data());
+
+                const size_t start = k * chunkSize;
+                filter.processBlock(samples + start, static_cast<int>(std::min(chunkSize, numSamples - start)));
+                filter.getState(finalStates.data() + k * stateSize);
+            });
+        }
+        pool.wait();
+
+        // 2. Entry states, s(k + 1) = A^L s(k) + e(k)
+        const Matrix lastTransition = power(numSamples - (numChunks - 1) * chunkSize);
+        std::copy(carriedState.begin(), carriedState.end(), entryStates.begin());
+        for (size_t k = 0; k < numChunks; ++k)
+        {
+            const Matrix& a     = k + 1 < numChunks ? chunkTransition : lastTransition;
+            const double* entry = entryStates.data() + k * stateSize;
+            double*       next  = k + 1 < numChunks ? entryStates.data() + (k + 1) * stateSize : carriedState.data();
+
+            std::vector<double> propagated(stateSize);
+            for (size_t i = 0; i < stateSize; ++i)
+            {
+                double sum = finalStates[k * stateSize + i];
+                for (size_t j = 0; j < stateSize; ++j)
+                    sum += a[i * stateSize + j] * entry[j];
+                propagated[i] = sum;
+            }
+            std::copy(propagated.begin(), propagated.end(), next);
+        }
+
+        // 3. Zero-input responses of the entry states
+        for (size_t k = 0; k < numChunks; ++k)
+        {
+            pool.submit([this, samples, numSamples, k](int workerIndex) {
+                const size_t start = k * chunkSize;
+                addZeroInputResponse(*filters[static_cast<size_t>(workerIndex)],
+                                     entryStates.data() + k * stateSize,
+                                     samples + start,
+                                     std::min(chunkSize, numSamples - start));
+            });
+        }
+        pool.wait();
+    }
+
+    void ParallelScanRenderer::addZeroInputResponse(WDFilter&     filter,
+                                                    const double* state,
+                                                    float*        samples,
+                                                    size_t        numSamples) const
+    {
+        if (std::all_of(state, state + stateSize, [](double s) { return std::abs(s) < settledLevel; }))
+            return;
+
+        filter.setState(state);
+        std::vector<double> current(stateSize);
+        for (size_t start = 0; start < numSamples; start += settleCheckInterval)
+        {
+            const size_t end = std::min(numSamples, start + settleCheckInterval);
+            for (size_t n = start; n < end; ++n)
+                samples[n] = static_cast<float>(samples[n] + filter.processSample(0.0));
+
+            filter.getState(current.data());
+            if (std::all_of(current.begin(), current.end(), [](double s) { return std::abs(s) < settledLevel; }))
+                return;
+        }
+    }
+
+    ParallelScanRenderer::Matrix ParallelScanRenderer::multiply(const Matrix& a, const Matrix& b) const
+    {
+        Matrix product(stateSize * stateSize, 0.0);
+        for (size_t i = 0; i < stateSize; ++i)
+            for (size_t k = 0; k < stateSize; ++k)
+                for (size_t j = 0; j < stateSize; ++j)
+                    product[i * stateSize + j] += a[i * stateSize + k] * b[k * stateSize + j];
+        return product;
+    }
+
+    // A^n by repeated squaring, in log2(n) products
+    ParallelScanRenderer::Matrix ParallelScanRenderer::power(size_t exponent) const
+    {
+        Matrix result(stateSize * stateSize, 0.0);
+        for (size_t i = 0; i < stateSize; ++i)
+            result[i * stateSize + i] = 1.0;
+
+        Matrix base = transition;
+        for (; exponent > 0; exponent >>= 1)
+        {
+            if ((exponent & 1) != 0)
+                result = multiply(result, base);
+            base = multiply(base, base);
+        }
+        return result;
+    }
+
+} // namespace utils
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <WDFilters/WDFilter.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "WorkStealingPool.h"
+
+namespace utils
+{
+
+    /**
+     * @brief Filters a long signal on several threads with the result of one sequential pass
+     *
+     * A linear filter's output over a chunk is the output from zero state (the zero-state
+     * response) plus the decay of the state it entered the chunk with (the zero-input
+     * response). Each call to process() runs in three steps:
+     *
+     * 1. Every chunk is filtered from zero state, in parallel, and its final state is kept.
+     * 2. The entry state of each chunk is propagated sequentially: s(k + 1) = A^L s(k) + e(k),
+     *    where e(k) is the final state of step 1 and A^L the state-transition matrix raised to
+     *    the chunk length. This costs a few small matrix-vector products per chunk.
+     * 3. Every chunk adds the zero-input response of its entry state, in parallel. The filter
+     *    runs on zeros from that state until the state has decayed below -200 dB, usually a
+     *    small fraction of the chunk.
+     *
+     * A is measured through the WDFilter state API: each column is the state after one sample
+     * of silence from a unit state. The state is carried from one call to the next, so a file
+     * can be processed in segments of bounded size. The output matches sequential processing
+     * to within float rounding.
+     */
+    class ParallelScanRenderer
+    {
+    public:
+        using FilterFactory = std::function<std::unique_ptr<WDFilter>()>;
+
+        static constexpr size_t defaultChunkSize = 65536;
+
+        /**
+         * @brief Creates one filter per worker and measures the state-transition matrix
+         * @param workerPool Pool the chunks run on; must outlive the renderer
+         * @param createFilter Returns a prepared filter with the settings to render; called once per worker
+         * @param samplesPerChunk Samples per chunk (at least 1024)
+         */
+        ParallelScanRenderer(WorkStealingPool&    workerPool,
+                             const FilterFactory& createFilter,
+                             size_t               samplesPerChunk = defaultChunkSize);
+
+        /**
+         * @brief Checks whether a filter exposes the state that a parallel render needs
+         * @param filter Filter to check
+         * @return True if the filter reports a state (WDFilter::getStateSize() > 0)
+         */
+        static bool supports(const WDFilter& filter) { return filter.getStateSize() > 0; }
+
+        /**
+         * @brief Filters the next segment of the signal in place
+         * @param samples Segment, continuing the signal of the previous call
+         * @param numSamples Number of samples in the segment
+         */
+        void process(float* samples, size_t numSamples);
+
+        /**
+         * @brief Clears the state carried between calls to process()
+         */
+        void reset();
+
+        size_t getChunkSize() const { return chunkSize; }
+
+    private:
+        using Matrix = std::vector<double>; // stateSize x stateSize, row-major
+
+        Matrix multiply(const Matrix& a, const Matrix& b) const;
+        Matrix power(size_t exponent) const;
+
+        void addZeroInputResponse(WDFilter& filter, const double* state, float* samples, size_t numSamples) const;
+
+        WorkStealingPool&                      pool;
+        std::vector<std::unique_ptr<WDFilter>> filters; // one per worker
+        size_t                                 chunkSize;
+        size_t                                 stateSize;
+
+        Matrix transition;      // A
+        Matrix chunkTransition; // A^chunkSize
+
+        std::vector<double> zeroState;
+        std::vector<double> carriedState;             // entry state of the next segment
+        std::vector<double> finalStates, entryStates; // per chunk, stateSize values each
+    };
+
+} // namespace utils
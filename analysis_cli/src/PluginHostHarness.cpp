@@ -0,0 +1,412 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include WDF_HARNESS_PROCESSOR_HEADER
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Defined by the plugin's PluginProcessor.cpp, exactly as a plugin host would call it
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+/**
+ * @brief Scripted automation of one plugin parameter
+ */
+struct Automation
+{
+    enum class Shape
+    {
+        Sine,  // 0.5 + 0.5 sin(2 pi rate t)
+        Ramp,  // rising sawtooth from 0 to 1, rate times per second
+        Random // new uniform value rate times per second
+    };
+
+    std::string                    parameterID;
+    Shape                          shape     = Shape::Sine;
+    double                         rateHz    = 1.0;
+    juce::AudioProcessorParameter* parameter = nullptr;
+    float                          value     = 0.0f;
+    double                         nextJump  = 0.0; // next change of a Shape::Random automation, in seconds
+};
+
+struct HarnessSettings
+{
+    std::vector<double>     sampleRates    = {44100.0, 48000.0, 96000.0};
+    std::vector<int>        blockSizes     = {32, 64, 128, 256, 512, 1024};
+    double                  seconds        = 5.0;
+    double                  budgetFraction = 1.0;
+    bool                    variableBlocks = false;
+    bool                    realtime       = false;
+    bool                    failOnMiss     = false;
+    int                     seed           = 1;
+    std::vector<Automation> automation;
+};
+
+/**
+ * @brief Parses a comma-separated list of numbers
+ * @param text List such as "64,128,256"
+ * @param values Receives the parsed values
+ * @return True if every entry is a positive number
+ */
+template <typename T>
+static bool parseList(const std::string& text, std::vector<T>& values)
+{
+    values.clear();
+    std::stringstream stream(text);
+    std::string       item;
+    while (std::getline(stream, item, ','))
+    {
+        std::stringstream itemStream(item);
+        T                 value{};
+        if (!(itemStream >> value) || value <= T{})
+            return false;
+        values.push_back(value);
+    }
+    return !values.empty();
+}
+
+/**
+ * @brief Parses an --automate argument of the form <parameter>:<sine|ramp|random>[:<rate Hz>]
+ * @param text Argument value
+ * @param automation Receives the parsed automation
+ * @return True if the argument is valid
+ */
+static bool parseAutomation(const std::string& text, Automation& automation)
+{
+    std::vector<std::string> fields;
+    std::stringstream        stream(text);
+    std::string              field;
+    while (std::getline(stream, field, ':'))
+        fields.push_back(field);
+
+    if (fields.size() < 2 || fields.size() > 3 || fields[0].empty())
+        return false;
+
+    automation.parameterID = fields[0];
+    if (fields[1] == "sine")
+        automation.shape = Automation::Shape::Sine;
+    else if (fields[1] == "ramp")
+        automation.shape = Automation::Shape::Ramp;
+    else if (fields[1] == "random")
+        automation.shape = Automation::Shape::Random;
+    else
+        return false;
+
+    if (fields.size() == 3)
+    {
+        std::stringstream rateStream(fields[2]);
+        if (!(rateStream >> automation.rateHz) || automation.rateHz <= 0.0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Resolves the parameter IDs of the automation script against the plugin
+ *
+ * The ID "all" expands to one automation per plugin parameter.
+ * @param processor Plugin instance
+ * @param automation Automation script; parameters are filled in and "all" is expanded
+ * @return True if every parameter ID exists
+ */
+static bool bindAutomation(juce::AudioProcessor& processor, std::vector<Automation>& automation)
+{
+    std::vector<Automation> bound;
+    for (const auto& entry : automation)
+    {
+        bool found = false;
+        for (auto* parameter : processor.getParameters())
+        {
+            const auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter);
+            if (withID == nullptr || (entry.parameterID != "all" && withID->paramID.toStdString() != entry.parameterID))
+                continue;
+
+            Automation resolved  = entry;
+            resolved.parameterID = withID->paramID.toStdString();
+            resolved.parameter   = parameter;
+            bound.push_back(resolved);
+            found = true;
+        }
+
+        if (!found)
+        {
+            std::cerr << "Unknown parameter: " << entry.parameterID << std::endl;
+            return false;
+        }
+    }
+
+    automation = std::move(bound);
+    return true;
+}
+
+/**
+ * @brief Moves every automated parameter to its value at the given time, the way a host does before a callback
+ * @param automation Bound automation script
+ * @param time Song position in seconds
+ * @param random Source for Shape::Random
+ */
+static void applyAutomation(std::vector<Automation>& automation, double time, juce::Random& random)
+{
+    for (auto& entry : automation)
+    {
+        switch (entry.shape)
+        {
+        case Automation::Shape::Sine:
+        {
+            const double phase = juce::MathConstants<double>::twoPi * entry.rateHz * time;
+            entry.value        = static_cast<float>(0.5 + 0.5 * std::sin(phase));
+            break;
+        }
+        case Automation::Shape::Ramp:
+            entry.value = static_cast<float>(entry.rateHz * time - std::floor(entry.rateHz * time));
+            break;
+        case Automation::Shape::Random:
+            if (time >= entry.nextJump)
+            {
+                entry.value    = random.nextFloat();
+                entry.nextJump = time + 1.0 / entry.rateHz;
+            }
+            break;
+        }
+
+        entry.parameter->setValue(entry.value);
+        entry.parameter->sendValueChangedMessageToListeners(entry.value);
+    }
+}
+
+/**
+ * @brief Accumulates the statistics of one drain of the block timer into a running total
+ * @param total Running total
+ * @param part Statistics returned by BlockTimer::collectStats()
+ */
+static void mergeStats(BlockTimingStats& total, const BlockTimingStats& part)
+{
+    if (part.numBlocks > 0)
+    {
+        const double totalSeconds = total.avgSeconds * static_cast<double>(total.numBlocks) +
+                                    part.avgSeconds * static_cast<double>(part.numBlocks);
+
+        total.minSeconds = total.numBlocks > 0 ? std::min(total.minSeconds, part.minSeconds) : part.minSeconds;
+        total.maxSeconds = std::max(total.maxSeconds, part.maxSeconds);
+        total.maxLoad    = std::max(total.maxLoad, part.maxLoad);
+        total.numBlocks += part.numBlocks;
+        total.avgSeconds = totalSeconds / static_cast<double>(total.numBlocks);
+    }
+
+    total.numSamples += part.numSamples;
+    total.deadlineMisses += part.deadlineMisses;
+    total.numDropped += part.numDropped;
+}
+
+/**
+ * @brief Drives the plugin through one host configuration
+ * @param processor Plugin instance
+ * @param timer The plugin's block timer
+ * @param sampleRate Sample rate in Hz
+ * @param maxBlockSize Block size passed to prepareToPlay(); with variable blocks each callback is 1..maxBlockSize
+ * @param settings Harness settings
+ * @param automation Bound automation script
+ * @return Timing statistics of every processBlock() call
+ */
+static BlockTimingStats runConfiguration(juce::AudioProcessor&    processor,
+                                         BlockTimer&              timer,
+                                         double                   sampleRate,
+                                         int                      maxBlockSize,
+                                         const HarnessSettings&   settings,
+                                         std::vector<Automation>& automation)
+{
+    // The ring holds BlockTimer::capacity entries; drain well before it fills
+    constexpr int drainInterval = static_cast<int>(BlockTimer::capacity / 4);
+
+    const int numChannels = std::max(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+
+    processor.setRateAndBufferSizeDetails(sampleRate, maxBlockSize);
+    processor.prepareToPlay(sampleRate, maxBlockSize);
+
+    juce::AudioBuffer<float> buffer(numChannels, maxBlockSize);
+    juce::MidiBuffer         midi;
+    juce::Random             random(settings.seed);
+
+    for (auto& entry : automation)
+        entry.nextJump = 0.0;
+
+    // Discard anything left over from the previous configuration
+    timer.collectStats(settings.budgetFraction);
+
+    BlockTimingStats total;
+    const auto       totalSamples  = static_cast<int64_t>(settings.seconds * sampleRate);
+    int64_t          position      = 0;
+    int              sinceDrain    = 0;
+    auto             blockDeadline = std::chrono::steady_clock::now();
+
+    while (position < totalSamples)
+    {
+        int numSamples = settings.variableBlocks ? random.nextInt(juce::Range<int>(1, maxBlockSize + 1)) : maxBlockSize;
+        numSamples     = static_cast<int>(std::min<int64_t>(numSamples, totalSamples - position));
+
+        // White noise at -6 dBFS so the nonlinear stages are exercised
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* data = buffer.getWritePointer(ch);
+            for (int n = 0; n < numSamples; ++n)
+                data[n] = random.nextFloat() - 0.5f;
+        }
+
+        applyAutomation(automation, static_cast<double>(position) / sampleRate, random);
+
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+        processor.processBlock(block, midi);
+        position += numSamples;
+
+        if (++sinceDrain == drainInterval)
+        {
+            mergeStats(total, timer.collectStats(settings.budgetFraction));
+            sinceDrain = 0;
+        }
+
+        // Pace the callbacks like an audio device would
+        if (settings.realtime)
+        {
+            blockDeadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(numSamples / sampleRate));
+            std::this_thread::sleep_until(blockDeadline);
+        }
+    }
+
+    mergeStats(total, timer.collectStats(settings.budgetFraction));
+    processor.releaseResources();
+    return total;
+}
+
+int main(int argc, char* argv[])
+{
+    HarnessSettings settings;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--sample-rates" && i + 1 < argc)
+        {
+            if (!parseList(argv[++i], settings.sampleRates))
+            {
+                std::cerr << "Invalid sample rate list: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--block-sizes" && i + 1 < argc)
+        {
+            if (!parseList(argv[++i], settings.blockSizes))
+            {
+                std::cerr << "Invalid block size list: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--automate" && i + 1 < argc)
+        {
+            Automation automation;
+            if (!parseAutomation(argv[++i], automation))
+            {
+                std::cerr << "Invalid automation: " << argv[i] << std::endl;
+                return 1;
+            }
+            settings.automation.push_back(automation);
+        }
+        else if (arg == "--seconds" && i + 1 < argc)
+            settings.seconds = std::stod(argv[++i]);
+        else if (arg == "--budget" && i + 1 < argc)
+            settings.budgetFraction = std::stod(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc)
+            settings.seed = std::stoi(argv[++i]);
+        else if (arg == "--variable-blocks")
+            settings.variableBlocks = true;
+        else if (arg == "--realtime")
+            settings.realtime = true;
+        else if (arg == "--fail-on-miss")
+            settings.failOnMiss = true;
+        else if (arg == "--help")
+        {
+            std::cout << "Usage: " << argv[0] << " [options]" << std::endl
+                      << "Options:" << std::endl
+                      << "  --sample-rates <list>     Sample rates in Hz (default: 44100,48000,96000)" << std::endl
+                      << "  --block-sizes <list>      Block sizes (default: 32,64,128,256,512,1024)" << std::endl
+                      << "  --variable-blocks         Draw each callback's size from 1..block size" << std::endl
+                      << "  --seconds <value>         Audio processed per configuration (default: 5)" << std::endl
+                      << "  --automate <id>:<shape>[:<Hz>]" << std::endl
+                      << "                            Automate a parameter (or 'all') with sine, ramp or random"
+                      << std::endl
+                      << "                            at the given rate (default: 1 Hz); may be repeated" << std::endl
+                      << "  --budget <fraction>       Share of the block duration a callback may take (default: 1)"
+                      << std::endl
+                      << "  --realtime                Pace callbacks in real time instead of back to back"
+                      << std::endl
+                      << "  --seed <n>                Seed for the input noise and random automation (default: 1)"
+                      << std::endl
+                      << "  --fail-on-miss            Exit with status 1 if any callback missed its deadline"
+                      << std::endl
+                      << "  --help                    Show this help message" << std::endl;
+            return 0;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << arg << " (see --help)" << std::endl;
+            return 1;
+        }
+    }
+
+    // Message manager for parameter listeners; no audio device or display is needed
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    std::unique_ptr<juce::AudioProcessor> processor(createPluginFilter());
+    auto* pluginProcessor = dynamic_cast<AudioPluginAudioProcessor*>(processor.get());
+    if (pluginProcessor == nullptr)
+    {
+        std::cerr << "Failed to create the plugin processor" << std::endl;
+        return 1;
+    }
+
+    if (!bindAutomation(*processor, settings.automation))
+        return 1;
+
+    std::cout << "Plugin: " << processor->getName() << " (" << processor->getTotalNumInputChannels() << " in, "
+              << processor->getTotalNumOutputChannels() << " out)" << std::endl;
+    for (const auto& entry : settings.automation)
+        std::cout << "Automating " << entry.parameterID << " at " << entry.rateHz << " Hz" << std::endl;
+    std::cout << settings.seconds << " s per configuration, " << (settings.realtime ? "real-time" : "back-to-back")
+              << " callbacks, budget " << settings.budgetFraction * 100.0 << "% of each block" << std::endl;
+
+    std::cout << std::endl
+              << std::right << std::setw(8) << "Rate" << std::setw(8) << "Block" << std::setw(10) << "Blocks"
+              << std::setw(11) << "Min [us]" << std::setw(11) << "Avg [us]" << std::setw(11) << "Max [us]"
+              << std::setw(10) << "Max load" << std::setw(8) << "Misses" << std::setw(9) << "Dropped" << std::endl;
+
+    uint64_t totalMisses = 0;
+    for (double sampleRate : settings.sampleRates)
+    {
+        for (int blockSize : settings.blockSizes)
+        {
+            const BlockTimingStats stats = runConfiguration(
+                *processor, pluginProcessor->getBlockTimer(), sampleRate, blockSize, settings, settings.automation);
+
+            std::cout << std::right << std::fixed << std::setprecision(0) << std::setw(8) << sampleRate << std::setw(8)
+                      << ((settings.variableBlocks ? "<=" : "") + std::to_string(blockSize)) << std::setw(10)
+                      << stats.numBlocks << std::setprecision(2) << std::setw(11)
+                      << stats.minSeconds * 1.0e6 << std::setw(11) << stats.avgSeconds * 1.0e6 << std::setw(11)
+                      << stats.maxSeconds * 1.0e6 << std::setw(9) << stats.maxLoad * 100.0 << "%" << std::setw(8)
+                      << stats.deadlineMisses << std::setw(9) << stats.numDropped << std::defaultfloat << std::endl;
+
+            totalMisses += stats.deadlineMisses;
+        }
+    }
+
+    std::cout << std::endl << totalMisses << " deadline miss(es)" << std::endl;
+
+    return settings.failOnMiss && totalMisses > 0 ? 1 : 0;
+}
@@ -4,13 +4,16 @@
 #include <WDFilters/LowPassFilter.h>
 #include <WDFilters/WDFilter.h>
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
 #include "Utils.h"
+#include "WorkStealingPool.h"
 
 /**
  * @brief Calculate the real-time factor for a filter
@@ -41,13 +44,36 @@ static double calculateRealTimeFactor(std::unique_ptr<WDFilter>& filter, double
     return wallSec / audioSec;
 }
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
+int main(int argc, char* argv[])
 {
     // Define constants
     constexpr double sampleRate  = 48000.0;
     constexpr double cutoffFreq  = 1000.0;
     constexpr double testSeconds = 30.0;
 
+    int numInstances = 1;
+    int numThreads   = 0;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--instances" && i + 1 < argc)
+            numInstances = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--threads" && i + 1 < argc)
+            numThreads = std::stoi(argv[++i]);
+        else if (arg == "--help")
+        {
+            std::cout << "Usage: RealTimeFactorAnalyzer [options]" << std::endl
+                      << "Options:" << std::endl
+                      << "  --instances <n>  Filter instances run at once, like tracks of a session (default: 1)"
+                      << std::endl
+                      << "  --threads <n>    Worker threads (default: hardware concurrency)" << std::endl
+                      << "  --help           Show this help message" << std::endl;
+            return 0;
+        }
+    }
+
     // Create output directory
     fs::path outputDir = fs::current_path() / "rtf_analysis";
     if (!utils::createDirectory(outputDir))
@@ -56,65 +82,64 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
         return 1;
     }
 
+    utils::WorkStealingPool pool(numThreads);
+
     std::cout << "Analyzing real-time factors for all filter types..." << std::endl;
     std::cout << "Output directory: " << outputDir.string() << std::endl;
     std::cout << "Test duration: " << testSeconds << " seconds" << std::endl;
     std::cout << "Sample rate: " << sampleRate << " Hz" << std::endl;
     std::cout << "Cutoff frequency: " << cutoffFreq << " Hz" << std::endl;
+    if (numInstances > 1)
+        std::cout << "Instances: " << numInstances << " on " << pool.getNumWorkers() << " thread(s)" << std::endl;
     std::cout << "\nResults:\n" << std::endl;
 
-    // Test low pass filters
-    {
-        auto filter = WDFilter::create(WDFilter::Type::LowPass, WDFilter::Order::First);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-        double rtf = calculateRealTimeFactor(filter, sampleRate, testSeconds);
-        std::cout << "LowPass (1st order): RTF = " << rtf << std::endl;
-    }
-
-    {
-        auto filter = WDFilter::create(WDFilter::Type::LowPass, WDFilter::Order::Second);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-        double rtf = calculateRealTimeFactor(filter, sampleRate, testSeconds);
-        std::cout << "LowPass (2nd order): RTF = " << rtf << std::endl;
-    }
-
-    // Test high pass filters
-    {
-        auto filter = WDFilter::create(WDFilter::Type::HighPass, WDFilter::Order::First);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-        double rtf = calculateRealTimeFactor(filter, sampleRate, testSeconds);
-        std::cout << "HighPass (1st order): RTF = " << rtf << std::endl;
-    }
-
-    {
-        auto filter = WDFilter::create(WDFilter::Type::HighPass, WDFilter::Order::Second);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-        double rtf = calculateRealTimeFactor(filter, sampleRate, testSeconds);
-        std::cout << "HighPass (2nd order): RTF = " << rtf << std::endl;
-    }
-
-    // Test band pass filters
+    struct FilterJob
     {
-        auto filter = WDFilter::create(WDFilter::Type::BandPass, WDFilter::Order::First);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-        double rtf = calculateRealTimeFactor(filter, sampleRate, testSeconds);
-        std::cout << "BandPass (1st order): RTF = " << rtf << std::endl;
-    }
-
+        WDFilter::Type  type;
+        WDFilter::Order order;
+        const char*     label;
+    };
+
+    const FilterJob jobs[] = {
+        {WDFilter::Type::LowPass, WDFilter::Order::First, "LowPass (1st order)"},
+        {WDFilter::Type::LowPass, WDFilter::Order::Second, "LowPass (2nd order)"},
+        {WDFilter::Type::HighPass, WDFilter::Order::First, "HighPass (1st order)"},
+        {WDFilter::Type::HighPass, WDFilter::Order::Second, "HighPass (2nd order)"},
+        {WDFilter::Type::BandPass, WDFilter::Order::First, "BandPass (1st order)"},
+        {WDFilter::Type::BandPass, WDFilter::Order::Second, "BandPass (2nd order)"},
+    };
+
+    // Each filter type runs on its own, with every instance a task of its own, so the instances
+    // compete for the cores the way the tracks of a session do
+    std::vector<double> rtfs(static_cast<size_t>(numInstances));
+    for (const auto& job : jobs)
     {
-        auto filter = WDFilter::create(WDFilter::Type::BandPass, WDFilter::Order::Second);
-        filter->prepare(sampleRate);
-        filter->setCutoff(cutoffFreq);
-        double rtf = calculateRealTimeFactor(filter, sampleRate, testSeconds);
-        std::cout << "BandPass (2nd order): RTF = " << rtf << std::endl;
+        using clock   = std::chrono::high_resolution_clock;
+        const auto t0 = clock::now();
+
+        for (size_t instance = 0; instance < rtfs.size(); ++instance)
+        {
+            pool.submit([&, instance](int) {
+                auto filter = WDFilter::create(job.type, job.order);
+                filter->prepare(sampleRate);
+                filter->setCutoff(cutoffFreq);
+                rtfs[instance] = calculateRealTimeFactor(filter, sampleRate, testSeconds);
+            });
+        }
+        pool.wait();
+
+        const double wallSec = std::chrono::duration<double>(clock::now() - t0).count();
+        const double meanRtf = std::accumulate(rtfs.begin(), rtfs.end(), 0.0) / numInstances;
+
+        if (numInstances == 1)
+            std::cout << job.label << ": RTF = " << meanRtf << std::endl;
+        else
+            std::cout << job.label << ": RTF = " << meanRtf << " per instance, "
+                      << wallSec / (numInstances * testSeconds) << " aggregate (wall time / total audio time)"
+                      << std::endl;
     }
 
     std::cout << "\nReal-time factor analysis complete." << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,326 @@
+#include <WDFilters/BandPassFilter.h>
+#include <WDFilters/HighPassFilter.h>
+#include <WDFilters/LowPassFilter.h>
+#include <WDFilters/WDFilter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "FrequencyResponse.h"
+#include "LTspiceParser.h"
+#include "Utils.h"
+#include "WorkStealingPool.h"
+
+/**
+ * @brief A reference response found in the reference directory
+ *
+ * Reference files follow the analyzer naming scheme with the producing tool as prefix,
+ * e.g. ltspice_BandPass_order2_1000Hz.csv or pywdf_LowPass_order1_1000Hz.csv. LTspice plot
+ * exports (.txt) and .raw files are read directly; their prefix is optional and defaults to "ltspice".
+ */
+struct ReferenceFile
+{
+    fs::path        path;
+    std::string     source;
+    std::string     typeName;
+    WDFilter::Type  type      = WDFilter::Type::LowPass;
+    WDFilter::Order order     = WDFilter::Order::First;
+    double          cutoff    = 1000.0;
+    bool            isLTspice = false;
+};
+
+/**
+ * @brief Comparison settings shared by all tasks
+ *
+ * The default band stops an octave above the 1 kHz references, where the bilinear
+ * transform's frequency warping is still well below the tolerances.
+ */
+struct ComparisonSettings
+{
+    double sampleRate      = 48000.0;
+    int    fftOrder        = 14;
+    double minFrequency    = 20.0;
+    double maxFrequency    = 2000.0;
+    double magnitudeTolDb  = 0.1;
+    double phaseTolDegrees = 1.0;
+
+    std::string traceName; // LTspice trace to compare; empty selects the first voltage trace
+};
+
+/**
+ * @brief Deviation of the analyzer response from one reference
+ */
+struct ComparisonResult
+{
+    bool   loaded       = false;
+    size_t numPoints    = 0;
+    double magnitudeMax = 0.0;
+    double magnitudeRms = 0.0;
+    double phaseMax     = 0.0;
+    double phaseRms     = 0.0;
+    bool   passed       = false;
+};
+
+/**
+ * @brief Parse a reference filename into source, filter type, order and cutoff
+ * @param path Path of the reference file
+ * @param reference Receives the parsed description
+ * @return True if the filename follows the reference naming scheme
+ */
+static bool parseReferenceFilename(const fs::path& path, ReferenceFile& reference)
+{
+    static const std::regex pattern(
+        R"(^(?:(.+)_)?(LowPass|HighPass|BandPass)_order([12])_([0-9]+)Hz\.(csv|txt|raw)$)");
+
+    const std::string filename = path.filename().string();
+    std::smatch       match;
+    if (!std::regex_match(filename, match, pattern))
+        return false;
+
+    reference.isLTspice = match[5] != "csv";
+    if (!reference.isLTspice && !match[1].matched)
+        return false;
+
+    reference.path     = path;
+    reference.source   = match[1].matched ? match[1].str() : std::string("ltspice");
+    reference.typeName = match[2];
+    reference.type     = reference.typeName == "LowPass"    ? WDFilter::Type::LowPass
+                         : reference.typeName == "HighPass" ? WDFilter::Type::HighPass
+                                                            : WDFilter::Type::BandPass;
+    reference.order    = match[3] == "2" ? WDFilter::Order::Second : WDFilter::Order::First;
+    reference.cutoff   = std::stod(match[4]);
+    return true;
+}
+
+/**
+ * @brief Unwrap a phase curve given in degrees so it can be interpolated
+ * @param phases Phase values in degrees, modified in place
+ */
+static void unwrapPhase(std::vector<double>& phases)
+{
+    double offset = 0.0;
+    for (size_t i = 1; i < phases.size(); ++i)
+    {
+        const double delta = phases[i] + offset - phases[i - 1];
+        offset -= 360.0 * std::round(delta / 360.0);
+        phases[i] += offset;
+    }
+}
+
+/**
+ * @brief Compare the analyzer response of a filter against one reference
+ *
+ * The reference is resampled onto the analyzer's FFT grid by linear interpolation over
+ * log-frequency. Both magnitude curves are normalized to their own peak, matching the
+ * analyzer's convention, and phase differences are wrapped to [-180, 180) degrees so the
+ * arbitrary multiple of 360 degrees left by unwrapping does not count as an error.
+ * @param reference Reference to compare against
+ * @param settings Comparison settings
+ * @return Deviation statistics
+ */
+static ComparisonResult compareReference(const ReferenceFile& reference, const ComparisonSettings& settings)
+{
+    ComparisonResult result;
+
+    std::vector<double> refFreq, refMag, refPhase;
+    if (reference.isLTspice)
+    {
+        utils::LTspiceData data;
+        if (!utils::readLTspice(reference.path, data) ||
+            !utils::toFrequencyResponse(data, settings.traceName, refFreq, refMag, refPhase))
+            return result;
+    }
+    else if (!utils::readCSV(reference.path, refFreq, refMag, refPhase))
+        return result;
+    result.loaded = true;
+
+    // Drop non-positive frequencies (DC bins) that have no place on a log axis
+    std::vector<double> logFreq;
+    std::vector<double> mag;
+    std::vector<double> phase;
+    for (size_t i = 0; i < refFreq.size(); ++i)
+    {
+        if (refFreq[i] <= 0.0)
+            continue;
+        logFreq.push_back(std::log(refFreq[i]));
+        mag.push_back(refMag[i]);
+        phase.push_back(refPhase[i]);
+    }
+    if (logFreq.size() < 2)
+        return result;
+
+    unwrapPhase(phase);
+    const double refPeak = *std::max_element(mag.begin(), mag.end());
+
+    auto filter = WDFilter::create(reference.type, reference.order);
+    filter->prepare(settings.sampleRate);
+    filter->setCutoff(reference.cutoff);
+    auto [frequencies, magnitudes, phases] =
+        utils::calculateFrequencyResponse(*filter, settings.sampleRate, settings.fftOrder);
+
+    double magnitudeSquares = 0.0;
+    double phaseSquares     = 0.0;
+    size_t segment          = 0;
+    for (size_t k = 0; k < frequencies.size(); ++k)
+    {
+        const double f = frequencies[k];
+        if (f < settings.minFrequency || f > settings.maxFrequency)
+            continue;
+
+        // The grid is ascending, so the enclosing reference segment only ever moves forward
+        const double x = std::log(f);
+        if (x < logFreq.front() || x > logFreq.back())
+            continue;
+        while (segment + 2 < logFreq.size() && logFreq[segment + 1] < x)
+            ++segment;
+
+        const double span = logFreq[segment + 1] - logFreq[segment];
+        const double t    = span > 0.0 ? (x - logFreq[segment]) / span : 0.0;
+
+        const double expectedMag   = mag[segment] + t * (mag[segment + 1] - mag[segment]) - refPeak;
+        const double expectedPhase = phase[segment] + t * (phase[segment + 1] - phase[segment]);
+
+        const double magnitudeError = std::abs(magnitudes[k] - expectedMag);
+        double       phaseError     = phases[k] - expectedPhase;
+        phaseError                  = std::abs(phaseError - 360.0 * std::round(phaseError / 360.0));
+
+        result.magnitudeMax = std::max(result.magnitudeMax, magnitudeError);
+        result.phaseMax     = std::max(result.phaseMax, phaseError);
+        magnitudeSquares += magnitudeError * magnitudeError;
+        phaseSquares += phaseError * phaseError;
+        ++result.numPoints;
+    }
+
+    if (result.numPoints > 0)
+    {
+        result.magnitudeRms = std::sqrt(magnitudeSquares / static_cast<double>(result.numPoints));
+        result.phaseRms     = std::sqrt(phaseSquares / static_cast<double>(result.numPoints));
+    }
+
+    result.passed = result.numPoints > 0 && result.magnitudeMax <= settings.magnitudeTolDb &&
+                    result.phaseMax <= settings.phaseTolDegrees;
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    ComparisonSettings settings;
+    fs::path           referenceDir = fs::current_path() / "frequency_responses";
+    std::string        sourceFilter;
+    int                numThreads = 0;
+
+    // Parse command line arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--refs" && i + 1 < argc)
+            referenceDir = argv[++i];
+        else if (arg == "--source" && i + 1 < argc)
+            sourceFilter = argv[++i];
+        else if (arg == "--fs" && i + 1 < argc)
+            settings.sampleRate = std::stod(argv[++i]);
+        else if (arg == "--fft-order" && i + 1 < argc)
+            settings.fftOrder = std::clamp(std::stoi(argv[++i]), 8, 20);
+        else if (arg == "--fmin" && i + 1 < argc)
+            settings.minFrequency = std::stod(argv[++i]);
+        else if (arg == "--fmax" && i + 1 < argc)
+            settings.maxFrequency = std::stod(argv[++i]);
+        else if (arg == "--mag-tol" && i + 1 < argc)
+            settings.magnitudeTolDb = std::stod(argv[++i]);
+        else if (arg == "--phase-tol" && i + 1 < argc)
+            settings.phaseTolDegrees = std::stod(argv[++i]);
+        else if (arg == "--trace" && i + 1 < argc)
+            settings.traceName = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc)
+            numThreads = std::stoi(argv[++i]);
+        else if (arg == "--help")
+        {
+            std::cout << "Usage: ReferenceComparator [options]" << std::endl
+                      << "Options:" << std::endl
+                      << "  --refs <dir>          Reference directory (default: ./frequency_responses)" << std::endl
+                      << "  --source <name>       Only compare references from this source, e.g. ltspice or pywdf"
+                      << std::endl
+                      << "  --fs <value>          Sample rate in Hz (default: 48000)" << std::endl
+                      << "  --fft-order <n>       FFT order of the analyzer grid (default: 14)" << std::endl
+                      << "  --fmin <value>        Lowest compared frequency in Hz (default: 20)" << std::endl
+                      << "  --fmax <value>        Highest compared frequency in Hz (default: 2000)" << std::endl
+                      << "  --mag-tol <dB>        Maximum magnitude deviation (default: 0.1)" << std::endl
+                      << "  --phase-tol <degrees> Maximum phase deviation (default: 1)" << std::endl
+                      << "  --trace <name>        LTspice trace to compare (default: first voltage trace)" << std::endl
+                      << "  --threads <n>         Worker threads (default: hardware concurrency)" << std::endl
+                      << "  --help                Show this help message" << std::endl;
+            return 0;
+        }
+    }
+
+    // Collect every reference response, in a stable order for the report
+    std::vector<ReferenceFile> references;
+    std::error_code            error;
+    for (const auto& entry : fs::directory_iterator(referenceDir, error))
+    {
+        ReferenceFile reference;
+        if (entry.is_regular_file() && parseReferenceFilename(entry.path(), reference) &&
+            (sourceFilter.empty() || reference.source == sourceFilter))
+            references.push_back(reference);
+    }
+
+    if (error || references.empty())
+    {
+        std::cerr << "No reference responses found in " << referenceDir.string() << std::endl;
+        return 1;
+    }
+
+    std::sort(references.begin(), references.end(), [](const ReferenceFile& a, const ReferenceFile& b) {
+        return a.path.filename() < b.path.filename();
+    });
+
+    std::cout << "Comparing " << references.size() << " reference response(s) from " << referenceDir.string()
+              << std::endl;
+    std::cout << "Band " << settings.minFrequency << "-" << settings.maxFrequency << " Hz, tolerance "
+              << settings.magnitudeTolDb << " dB / " << settings.phaseTolDegrees << " deg" << std::endl;
+
+    // Every comparison is independent; each task writes only its own result slot
+    std::vector<ComparisonResult> results(references.size());
+    {
+        utils::WorkStealingPool pool(numThreads);
+        for (size_t i = 0; i < references.size(); ++i)
+            pool.submit([&, i](int) { results[i] = compareReference(references[i], settings); });
+        pool.wait();
+    }
+
+    std::cout << std::endl
+              << std::left << std::setw(14) << "Source" << std::setw(10) << "Filter" << std::setw(7) << "Order"
+              << std::setw(9) << "Cutoff" << std::right << std::setw(8) << "Points" << std::setw(12) << "Mag max"
+              << std::setw(12) << "Mag RMS" << std::setw(12) << "Phase max" << std::setw(12) << "Phase RMS"
+              << "  Result" << std::endl;
+
+    int numFailed = 0;
+    for (size_t i = 0; i < references.size(); ++i)
+    {
+        const ReferenceFile&    reference = references[i];
+        const ComparisonResult& result    = results[i];
+
+        std::cout << std::left << std::setw(14) << reference.source << std::setw(10) << reference.typeName
+                  << std::setw(7) << (reference.order == WDFilter::Order::First ? 1 : 2) << std::setw(9)
+                  << reference.cutoff << std::right << std::setw(8) << result.numPoints << std::fixed
+                  << std::setprecision(4) << std::setw(12) << result.magnitudeMax << std::setw(12)
+                  << result.magnitudeRms << std::setw(12) << result.phaseMax << std::setw(12) << result.phaseRms
+                  << std::defaultfloat << "  " << (!result.loaded ? "ERROR" : result.passed ? "PASS" : "FAIL")
+                  << std::endl;
+
+        if (!result.passed)
+            ++numFailed;
+    }
+
+    std::cout << std::endl
+              << (references.size() - static_cast<size_t>(numFailed)) << "/" << references.size()
+              << " comparison(s) within tolerance" << std::endl;
+
+    return numFailed == 0 ? 0 : 1;
+}
@@ -1,11 +1,27 @@
 #include "Utils.h"
 #include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
-#include <iomanip>
+#include <iterator>
 
 namespace utils
 {
 
+    bool parseOutputFormat(const std::string& name, OutputFormat& format)
+    {
+        if (name == "csv")
+            format = OutputFormat::CSV;
+        else if (name == "npy")
+            format = OutputFormat::Npy;
+        else if (name == "both")
+            format = OutputFormat::Both;
+        else
+            return false;
+        return true;
+    }
+
     bool createDirectory(const fs::path& directoryPath)
     {
         if (fs::exists(directoryPath))
@@ -44,25 +60,16 @@ namespace utils
 
         try
         {
-            std::ofstream file(filePath);
-            if (!file.is_open())
-            {
-                std::cerr << "Error: Could not open file " << filePath << " for writing." << std::endl;
-                return false;
-            }
-
             // Write header with units
-            file << "frequency_hz,magnitude_db,phase_degrees" << std::endl;
+            CSVStreamWriter writer;
+            if (!writer.open(filePath, "frequency_hz,magnitude_db,phase_degrees"))
+                return false;
 
             // Write data with high precision
-            file << std::fixed << std::setprecision(6);
-            for (size_t i = 0; i < frequencies.size(); ++i)
-            {
-                file << frequencies[i] << "," << magnitudes[i] << "," << phases[i] << std::endl;
-            }
+            const double* columns[] = {frequencies.data(), magnitudes.data(), phases.data()};
+            writer.writeFixedRows(columns, 3, frequencies.size(), 6);
 
-            file.close();
-            return true;
+            return writer.close();
         }
         catch (const std::exception& e)
         {
@@ -71,6 +78,69 @@ namespace utils
         }
     }
 
+    bool readCSV(const fs::path&      filePath,
+                 std::vector<double>& frequencies,
+                 std::vector<double>& magnitudes,
+                 std::vector<double>& phases)
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Error: Could not open file " << filePath << " for reading." << std::endl;
+            return false;
+        }
+
+        const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        frequencies.clear();
+        magnitudes.clear();
+        phases.clear();
+
+        // Skip the header line
+        const char* cursor = text.c_str();
+        const char* end    = cursor + text.size();
+        while (cursor < end && *cursor != '\n')
+            ++cursor;
+
+        while (cursor < end)
+        {
+            // Skip line breaks (including CR from files written on Windows) and blank lines
+            while (cursor < end && (*cursor == '\n' || *cursor == '\r'))
+                ++cursor;
+            if (cursor == end)
+                break;
+
+            double values[3];
+            for (int column = 0; column < 3; ++column)
+            {
+                char* next     = nullptr;
+                values[column] = std::strtod(cursor, &next);
+                if (next == cursor || (column < 2 && *next != ','))
+                {
+                    std::cerr << "Error: Malformed line " << frequencies.size() + 2 << " in " << filePath << std::endl;
+                    return false;
+                }
+                cursor = column < 2 ? next + 1 : next;
+            }
+
+            frequencies.push_back(values[0]);
+            magnitudes.push_back(values[1]);
+            phases.push_back(values[2]);
+
+            // Ignore anything after the third column
+            while (cursor < end && *cursor != '\n')
+                ++cursor;
+        }
+
+        if (frequencies.empty())
+        {
+            std::cerr << "Error: No data found in " << filePath << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
     bool writeWaveformCSV(const fs::path&           filePath,
                           const std::vector<float>& timePoints,
                           const std::vector<float>& amplitudes,
@@ -84,22 +154,14 @@ namespace utils
 
         try
         {
-            std::ofstream file(filePath);
-            if (!file.is_open())
-            {
-                std::cerr << "Error: Could not open file " << filePath << " for writing." << std::endl;
+            CSVStreamWriter writer;
+            if (!writer.open(filePath, headers))
                 return false;
-            }
-
-            file << headers << std::endl;
 
-            for (size_t i = 0; i < timePoints.size(); ++i)
-            {
-                file << timePoints[i] << "," << amplitudes[i] << std::endl;
-            }
+            const float* columns[] = {amplitudes.data()};
+            writer.writeRows(timePoints.data(), columns, 1, timePoints.size());
 
-            file.close();
-            return true;
+            return writer.close();
         }
         catch (const std::exception& e)
         {
@@ -121,91 +183,613 @@ namespace utils
 
         try
         {
-            std::ofstream file(filePath);
-            if (!file.is_open())
-            {
-                std::cerr << "Error: Could not open file " << filePath << " for writing." << std::endl;
+            CSVStreamWriter writer;
+            if (!writer.open(filePath, "Time (s),Input Amplitude,Output Amplitude"))
                 return false;
+
+            const float* columns[] = {inputAmplitudes.data(), outputAmplitudes.data()};
+            writer.writeRows(timePoints.data(), columns, 2, timePoints.size());
+
+            return writer.close();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error writing comparison CSV file: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    bool exportWAV(const fs::path& filePath, const std::vector<float>& samples, double sampleRate)
+    {
+        WAVStreamWriter writer;
+        if (!writer.open(filePath, sampleRate))
+            return false;
+
+        if (!writer.write(samples.data(), samples.size()))
+            return false;
+
+        return writer.close();
+    }
+
+    namespace
+    {
+        // Upper bounds on the text std::to_chars produces for the formats used by CSVStreamWriter:
+        // a float with 6 significant digits ("-1.23457e-38") and a fixed-notation double, whose
+        // integer part can have up to 309 digits
+        constexpr size_t maxGeneralFloatChars = 16;
+        constexpr size_t maxFixedIntegerChars = 311;
+    } // namespace
+
+    CSVStreamWriter::~CSVStreamWriter()
+    {
+        if (isOpen())
+            close();
+    }
+
+    bool CSVStreamWriter::open(const fs::path& filePath, const std::string& headers, bool backgroundWrites)
+    {
+        path = filePath;
+        file.open(filePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Error: Could not open file " << filePath << " for writing." << std::endl;
+            return false;
+        }
+
+        buffer.resize(std::max(bufferCapacity, headers.size() + 1));
+        used        = 0;
+        writeFailed = false;
+        stopWriter  = false;
+        hasPending  = false;
+
+        std::memcpy(buffer.data(), headers.data(), headers.size());
+        used           = headers.size();
+        buffer[used++] = '\n';
+
+        if (backgroundWrites)
+            writerThread = std::thread([this] { writerLoop(); });
+
+        return true;
+    }
+
+    bool CSVStreamWriter::writeRows(const float*        timePoints,
+                                    const float* const* columns,
+                                    size_t              numColumns,
+                                    size_t              numRows)
+    {
+        if (!file.is_open())
+            return false;
+
+        const size_t maxRowChars = (numColumns + 1) * (maxGeneralFloatChars + 1);
+
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            ensureSpace(maxRowChars);
+
+            char* out = buffer.data() + used;
+            char* end = buffer.data() + buffer.size();
+
+            // chars_format::general with precision 6 matches the iostream default (%g)
+            out = std::to_chars(out, end, timePoints[i], std::chars_format::general, 6).ptr;
+            for (size_t c = 0; c < numColumns; ++c)
+            {
+                *out++ = ',';
+                out    = std::to_chars(out, end, columns[c][i], std::chars_format::general, 6).ptr;
             }
+            *out++ = '\n';
 
-            file << "Time (s),Input Amplitude,Output Amplitude" << std::endl;
+            used = static_cast<size_t>(out - buffer.data());
+        }
+
+        return !writeFailed;
+    }
+
+    bool CSVStreamWriter::writeFixedRows(const double* const* columns, size_t numColumns, size_t numRows, int decimals)
+    {
+        if (!file.is_open() || numColumns == 0)
+            return false;
+
+        const size_t maxRowChars = numColumns * (maxFixedIntegerChars + static_cast<size_t>(decimals) + 1);
+
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            ensureSpace(maxRowChars);
+
+            char* out = buffer.data() + used;
+            char* end = buffer.data() + buffer.size();
 
-            for (size_t i = 0; i < timePoints.size(); ++i)
+            for (size_t c = 0; c < numColumns; ++c)
             {
-                file << timePoints[i] << "," << inputAmplitudes[i] << "," << outputAmplitudes[i] << std::endl;
+                if (c > 0)
+                    *out++ = ',';
+                out = std::to_chars(out, end, columns[c][i], std::chars_format::fixed, decimals).ptr;
             }
+            *out++ = '\n';
 
-            file.close();
-            return true;
+            used = static_cast<size_t>(out - buffer.data());
         }
-        catch (const std::exception& e)
+
+        return !writeFailed;
+    }
+
+    bool CSVStreamWriter::close()
+    {
+        if (!file.is_open())
+            return false;
+
+        submitBuffer();
+
+        if (writerThread.joinable())
         {
-            std::cerr << "Error writing comparison CSV file: " << e.what() << std::endl;
+            {
+                std::lock_guard<std::mutex> lock(writerMutex);
+                stopWriter = true;
+            }
+            writerCondition.notify_all();
+            writerThread.join();
+        }
+
+        file.close();
+
+        const bool ok = !writeFailed && !file.fail();
+        if (!ok)
+            std::cerr << "Error writing CSV file " << path << std::endl;
+
+        return ok;
+    }
+
+    void CSVStreamWriter::ensureSpace(size_t numBytes)
+    {
+        if (used + numBytes > buffer.size())
+        {
+            submitBuffer();
+            if (buffer.size() < numBytes)
+                buffer.resize(numBytes);
+        }
+    }
+
+    void CSVStreamWriter::submitBuffer()
+    {
+        if (used == 0)
+            return;
+
+        if (!writerThread.joinable())
+        {
+            if (!file.write(buffer.data(), static_cast<std::streamsize>(used)))
+                writeFailed = true;
+            used = 0;
+            return;
+        }
+
+        // Hand the filled buffer to the writer thread and continue formatting into the one it released
+        std::unique_lock<std::mutex> lock(writerMutex);
+        writerCondition.wait(lock, [this] { return !hasPending; });
+        std::swap(buffer, pending);
+        pendingSize = used;
+        hasPending  = true;
+        lock.unlock();
+        writerCondition.notify_all();
+
+        used = 0;
+        if (buffer.size() < bufferCapacity)
+            buffer.resize(bufferCapacity);
+    }
+
+    void CSVStreamWriter::writerLoop()
+    {
+        std::unique_lock<std::mutex> lock(writerMutex);
+        for (;;)
+        {
+            writerCondition.wait(lock, [this] { return hasPending || stopWriter; });
+            if (!hasPending)
+                return;
+
+            lock.unlock();
+            const bool ok = static_cast<bool>(file.write(pending.data(), static_cast<std::streamsize>(pendingSize)));
+            lock.lock();
+
+            if (!ok)
+                writeFailed = true;
+            hasPending = false;
+            writerCondition.notify_all();
+        }
+    }
+
+    NpyStreamWriter::~NpyStreamWriter()
+    {
+        if (isOpen())
+            close();
+    }
+
+    bool NpyStreamWriter::open(const fs::path& filePath, const std::vector<std::string>& fieldNames, DType dtype)
+    {
+        // The dtype is declared little-endian and the data is written in host order
+        const uint16_t probe = 1;
+        if (*reinterpret_cast<const unsigned char*>(&probe) != 1)
+        {
+            std::cerr << "Error: .npy export requires a little-endian host." << std::endl;
+            return false;
+        }
+
+        path           = filePath;
+        fields         = fieldNames;
+        storageType    = dtype;
+        numRowsWritten = 0;
+
+        file.open(filePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Error: Could not open file " << filePath << " for writing." << std::endl;
             return false;
         }
+
+        // Reserve room for the largest possible row count so close() can patch the header in place
+        const std::string header = buildHeader(UINT64_MAX);
+        headerSize               = header.size();
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        return static_cast<bool>(file);
     }
 
-    bool exportWAV(const fs::path& filePath, const std::vector<float>& samples, double sampleRate)
+    std::string NpyStreamWriter::buildHeader(uint64_t numRows) const
     {
-        try
+        const char* typeCode = storageType == DType::Float32 ? "'<f4'" : "'<f8'";
+
+        std::string dict = "{'descr': [";
+        for (size_t i = 0; i < fields.size(); ++i)
+        {
+            if (i > 0)
+                dict += ", ";
+            dict += "('" + fields[i] + "', " + typeCode + ")";
+        }
+        dict += "], 'fortran_order': False, 'shape': (" + std::to_string(numRows) + ",), }";
+
+        // Pad with spaces so the data starts on a 64-byte boundary; the final byte is a newline.
+        // The padding is sized for a 20-digit row count, so every header built here has the same length.
+        constexpr size_t preambleSize = 10; // magic, version and header length
+        const size_t     maxDictSize  = dict.size() - std::to_string(numRows).size() + 20;
+        const size_t     totalSize    = (preambleSize + maxDictSize + 1 + 63) / 64 * 64;
+        dict.append(totalSize - preambleSize - dict.size() - 1, ' ');
+        dict += '\n';
+
+        const uint16_t headerLength = static_cast<uint16_t>(dict.size());
+
+        std::string header("\x93NUMPY\x01\x00", 8);
+        header += static_cast<char>(headerLength & 0xFF);
+        header += static_cast<char>(headerLength >> 8);
+        header += dict;
+        return header;
+    }
+
+    template <typename SourceType>
+    bool NpyStreamWriter::writeRowsImpl(const SourceType* const* columns, size_t numRows)
+    {
+        if (!file.is_open())
+            return false;
+
+        const size_t numFields = fields.size();
+        const size_t itemSize  = storageType == DType::Float32 ? sizeof(float) : sizeof(double);
+        buffer.resize(numRows * numFields * itemSize);
+
+        // Interleave the columns into rows of the structured dtype
+        char* out = buffer.data();
+        for (size_t i = 0; i < numRows; ++i)
+        {
+            for (size_t c = 0; c < numFields; ++c)
+            {
+                if (storageType == DType::Float32)
+                {
+                    const float value = static_cast<float>(columns[c][i]);
+                    std::memcpy(out, &value, sizeof(value));
+                }
+                else
+                {
+                    const double value = static_cast<double>(columns[c][i]);
+                    std::memcpy(out, &value, sizeof(value));
+                }
+                out += itemSize;
+            }
+        }
+
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        numRowsWritten += numRows;
+
+        if (!file)
+        {
+            std::cerr << "Error writing NumPy file " << path << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool NpyStreamWriter::writeRows(const float* const* columns, size_t numRows)
+    {
+        return writeRowsImpl(columns, numRows);
+    }
+
+    bool NpyStreamWriter::writeRows(const double* const* columns, size_t numRows)
+    {
+        return writeRowsImpl(columns, numRows);
+    }
+
+    bool NpyStreamWriter::close()
+    {
+        if (!file.is_open())
+            return false;
+
+        const std::string header = buildHeader(numRowsWritten);
+        file.seekp(0);
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        file.close();
+        return header.size() == headerSize && !file.fail();
+    }
+
+    bool writeNpy(const fs::path&            filePath,
+                  const std::vector<double>& frequencies,
+                  const std::vector<double>& magnitudes,
+                  const std::vector<double>& phases)
+    {
+        if (frequencies.size() != magnitudes.size() || frequencies.size() != phases.size())
+        {
+            std::cerr << "Error: Frequency, magnitude, and phase vectors must have the same size." << std::endl;
+            return false;
+        }
+
+        NpyStreamWriter writer;
+        if (!writer.open(filePath,
+                         {"frequency_hz", "magnitude_db", "phase_degrees"},
+                         NpyStreamWriter::DType::Float64))
+            return false;
+
+        const double* columns[] = {frequencies.data(), magnitudes.data(), phases.data()};
+        writer.writeRows(columns, frequencies.size());
+
+        return writer.close();
+    }
+
+    WAVStreamWriter::~WAVStreamWriter()
+    {
+        if (isOpen())
+            close();
+    }
+
+    bool WAVStreamWriter::open(
+        const fs::path& filePath, double sampleRate, int numChannels, SampleFormat format, bool dither)
+    {
+        path = filePath;
+        file.open(filePath, std::ios::binary);
+        if (!file.is_open())
         {
-            // For simplicity, we'll write a basic WAV file manually
-            // This avoids adding JUCE audio format dependencies
-            std::ofstream file(filePath, std::ios::binary);
-            if (!file.is_open())
+            std::cerr << "Error: Could not open file " << filePath << " for writing." << std::endl;
+            return false;
+        }
+
+        sampleFormat = format;
+        useDither    = dither && format != SampleFormat::Float32;
+        channels     = static_cast<uint16_t>(std::max(1, numChannels));
+        rate         = static_cast<uint32_t>(sampleRate);
+        dataBytes    = 0;
+
+        // Provisional header with the same layout as the final one, patched in close()
+        const std::vector<char> header = buildHeader(0, false);
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        return static_cast<bool>(file);
+    }
+
+    std::vector<char> WAVStreamWriter::buildHeader(uint64_t numDataBytes, bool rf64) const
+    {
+        std::vector<char> header;
+
+        auto putTag = [&header](const char* tag) { header.insert(header.end(), tag, tag + 4); };
+        auto putLE  = [&header](uint64_t value, int numBytes) {
+            for (int i = 0; i < numBytes; ++i)
+                header.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        };
+
+        const bool     isFloat       = sampleFormat == SampleFormat::Float32;
+        const uint16_t bitsPerSample =
+            sampleFormat == SampleFormat::PCM16 ? 16 : (sampleFormat == SampleFormat::PCM24 ? 24 : 32);
+        const uint16_t blockAlign    = static_cast<uint16_t>(channels * bitsPerSample / 8);
+        const uint16_t formatTag     = isFloat ? 3 : 1;
+        const bool     extensible    = channels > 2; // more than two channels requires WAVE_FORMAT_EXTENSIBLE
+        const uint32_t fmtSize       = extensible ? 40 : (isFloat ? 18 : 16);
+        const bool     hasFact       = isFloat; // non-PCM formats carry a fact chunk
+        const uint64_t numFrames     = numDataBytes / blockAlign;
+
+        const uint64_t riffSize = 4 + (8 + 28) + (8 + fmtSize) + (hasFact ? 12 : 0) + 8 + numDataBytes +
+                                  (numDataBytes & 1);
+
+        // RIFF (or RF64) header
+        putTag(rf64 ? "RF64" : "RIFF");
+        putLE(rf64 ? 0xFFFFFFFFu : riffSize, 4);
+        putTag("WAVE");
+
+        // ds64 chunk for RF64; otherwise a JUNK chunk of the same size reserves its place
+        putTag(rf64 ? "ds64" : "JUNK");
+        putLE(28, 4);
+        putLE(rf64 ? riffSize : 0, 8);
+        putLE(rf64 ? numDataBytes : 0, 8);
+        putLE(rf64 ? numFrames : 0, 8);
+        putLE(0, 4); // no table entries
+
+        // Format chunk
+        putTag("fmt ");
+        putLE(fmtSize, 4);
+        putLE(extensible ? 0xFFFEu : formatTag, 2);
+        putLE(channels, 2);
+        putLE(rate, 4);
+        putLE(static_cast<uint64_t>(rate) * blockAlign, 4);
+        putLE(blockAlign, 2);
+        putLE(bitsPerSample, 2);
+        if (fmtSize > 16)
+            putLE(extensible ? 22 : 0, 2);
+        if (extensible)
+        {
+            putLE(bitsPerSample, 2); // valid bits per sample
+            putLE(0, 4);             // no speaker assignment
+            // Sub-format GUID xxxxxxxx-0000-0010-8000-00AA00389B71 with the format tag in front
+            const unsigned char guidTail[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80,
+                                                0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+            putLE(formatTag, 2);
+            header.insert(header.end(), guidTail, guidTail + 14);
+        }
+
+        if (hasFact)
+        {
+            putTag("fact");
+            putLE(4, 4);
+            putLE(rf64 ? 0xFFFFFFFFu : numFrames, 4);
+        }
+
+        // Data chunk
+        putTag("data");
+        putLE(rf64 ? 0xFFFFFFFFu : numDataBytes, 4);
+
+        return header;
+    }
+
+    bool WAVStreamWriter::write(const float* samples, size_t numFrames)
+    {
+        if (!file.is_open())
+            return false;
+
+        for (size_t start = 0; start < numFrames; start += chunkFrames)
+        {
+            const size_t numInChunk = std::min(chunkFrames, numFrames - start);
+            if (!writeInterleavedChunk(samples + start * channels, numInChunk * channels))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool WAVStreamWriter::write(const float* const* channelData, size_t numFrames)
+    {
+        if (!file.is_open())
+            return false;
+
+        interleaveBuffer.resize(std::min(chunkFrames, numFrames) * channels);
+
+        for (size_t start = 0; start < numFrames; start += chunkFrames)
+        {
+            const size_t numInChunk = std::min(chunkFrames, numFrames - start);
+
+            for (size_t ch = 0; ch < channels; ++ch)
             {
-                std::cerr << "Error: Could not open file " << filePath << " for writing." << std::endl;
+                const float* source = channelData[ch] + start;
+                for (size_t n = 0; n < numInChunk; ++n)
+                    interleaveBuffer[n * channels + ch] = source[n];
+            }
+
+            if (!writeInterleavedChunk(interleaveBuffer.data(), numInChunk * channels))
                 return false;
+        }
+
+        return true;
+    }
+
+    bool WAVStreamWriter::writeInterleavedChunk(const float* samples, size_t numSamples)
+    {
+        const size_t bytesPerSample =
+            sampleFormat == SampleFormat::PCM16 ? 2 : (sampleFormat == SampleFormat::PCM24 ? 3 : 4);
+        byteBuffer.resize(numSamples * bytesPerSample);
+        unsigned char* bytes = reinterpret_cast<unsigned char*>(byteBuffer.data());
+
+        if (sampleFormat == SampleFormat::Float32)
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                uint32_t bits;
+                std::memcpy(&bits, samples + i, sizeof(bits));
+                bytes[4 * i]     = static_cast<unsigned char>(bits);
+                bytes[4 * i + 1] = static_cast<unsigned char>(bits >> 8);
+                bytes[4 * i + 2] = static_cast<unsigned char>(bits >> 16);
+                bytes[4 * i + 3] = static_cast<unsigned char>(bits >> 24);
+            }
+        }
+        else
+        {
+            const float scale = sampleFormat == SampleFormat::PCM16 ? 32767.0f : 8388607.0f;
+
+            // Dither in LSBs: the sum of two independent uniform values in [-0.5, 0.5) is
+            // triangular over [-1, 1). The generator is sequential, so it fills its own buffer
+            // and the conversion loop below stays branch-free.
+            scaledBuffer.assign(numSamples, 0.0f);
+            if (useDither)
+            {
+                auto nextUniform = [this] {
+                    ditherState ^= ditherState << 13;
+                    ditherState ^= ditherState >> 17;
+                    ditherState ^= ditherState << 5;
+                    return static_cast<float>(ditherState >> 8) * (1.0f / 16777216.0f) - 0.5f;
+                };
+                for (size_t i = 0; i < numSamples; ++i)
+                    scaledBuffer[i] = nextUniform() + nextUniform();
             }
 
-            // Number of samples
-            const uint32_t dataSize = static_cast<uint32_t>(samples.size() * sizeof(int16_t));
-            const uint32_t fileSize = 36 + dataSize;
-
-            // WAV header (44 bytes)
-            // RIFF header
-            file.write("RIFF", 4);
-            file.write(reinterpret_cast<const char*>(&fileSize), 4);
-            file.write("WAVE", 4);
-
-            // Format chunk
-            file.write("fmt ", 4);
-            uint32_t fmtSize = 16;
-            file.write(reinterpret_cast<const char*>(&fmtSize), 4);
-            uint16_t audioFormat = 1; // PCM
-            file.write(reinterpret_cast<const char*>(&audioFormat), 2);
-            uint16_t numChannels = 1; // Mono
-            file.write(reinterpret_cast<const char*>(&numChannels), 2);
-            uint32_t sampleRateInt = static_cast<uint32_t>(sampleRate);
-            file.write(reinterpret_cast<const char*>(&sampleRateInt), 4);
-            uint32_t byteRate = sampleRateInt * numChannels * sizeof(int16_t);
-            file.write(reinterpret_cast<const char*>(&byteRate), 4);
-            uint16_t blockAlign = numChannels * sizeof(int16_t);
-            file.write(reinterpret_cast<const char*>(&blockAlign), 2);
-            uint16_t bitsPerSample = 16;
-            file.write(reinterpret_cast<const char*>(&bitsPerSample), 2);
-
-            // Data chunk
-            file.write("data", 4);
-            file.write(reinterpret_cast<const char*>(&dataSize), 4);
-
-            // Write sample data (convert float to int16_t)
-            for (float sample : samples)
+            // Scale, dither, clip and round half away from zero
+            intBuffer.resize(numSamples);
+            const float* noise = scaledBuffer.data();
+            int32_t*     pcm   = intBuffer.data();
+            for (size_t i = 0; i < numSamples; ++i)
             {
-                // Clip and convert to int16_t
-                float   clipped   = std::max(-1.0f, std::min(1.0f, sample));
-                int16_t pcmSample = static_cast<int16_t>(clipped * 32767.0f);
-                file.write(reinterpret_cast<const char*>(&pcmSample), sizeof(int16_t));
+                float y = samples[i] * scale + noise[i];
+                y       = std::min(scale, std::max(-scale, y));
+                pcm[i]  = static_cast<int32_t>(y + (y < 0.0f ? -0.5f : 0.5f));
             }
 
-            file.close();
-            return true;
+            if (sampleFormat == SampleFormat::PCM16)
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    bytes[2 * i]     = static_cast<unsigned char>(pcm[i]);
+                    bytes[2 * i + 1] = static_cast<unsigned char>(pcm[i] >> 8);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    bytes[3 * i]     = static_cast<unsigned char>(pcm[i]);
+                    bytes[3 * i + 1] = static_cast<unsigned char>(pcm[i] >> 8);
+                    bytes[3 * i + 2] = static_cast<unsigned char>(pcm[i] >> 16);
+                }
+            }
         }
-        catch (const std::exception& e)
+
+        file.write(byteBuffer.data(), static_cast<std::streamsize>(byteBuffer.size()));
+        dataBytes += byteBuffer.size();
+
+        if (!file)
         {
-            std::cerr << "Error exporting WAV file: " << e.what() << std::endl;
+            std::cerr << "Error exporting WAV file " << path << std::endl;
             return false;
         }
+
+        return true;
+    }
+
+    bool WAVStreamWriter::close()
+    {
+        if (!file.is_open())
+            return false;
+
+        // Chunks are word aligned
+        if (dataBytes & 1)
+            file.put(0);
+
+        const uint64_t riffPayload = buildHeader(dataBytes, false).size() - 8 + dataBytes + (dataBytes & 1);
+        const bool     rf64        = riffPayload > 0xFFFFFFFFull;
+
+        const std::vector<char> header = buildHeader(dataBytes, rf64);
+        file.seekp(0);
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        file.close();
+        return !file.fail();
     }
 
     std::string generateFilename(const std::string& filterType, int filterOrder, double cutoffFrequency)
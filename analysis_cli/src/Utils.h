@@ -1,10 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -12,6 +17,24 @@ namespace fs = std::filesystem;
 namespace utils
 {
 
+    /**
+     * @brief File formats the analyzers can emit
+     */
+    enum class OutputFormat
+    {
+        CSV,
+        Npy,
+        Both
+    };
+
+    /**
+     * @brief Parses an output format given on the command line
+     * @param name One of "csv", "npy" or "both"
+     * @param format Receives the parsed format
+     * @return True if the name was recognized
+     */
+    bool parseOutputFormat(const std::string& name, OutputFormat& format);
+
     /**
      * @brief Creates a directory if it doesn't exist
      * @param directoryPath Path to the directory to create
@@ -32,6 +55,21 @@ namespace utils
                   const std::vector<double>& magnitudes,
                   const std::vector<double>& phases);
 
+    /**
+     * @brief Reads a frequency response CSV file as written by writeCSV()
+     *
+     * The header line is skipped; every following line holds frequency, magnitude and phase.
+     * @param filePath Path to the CSV file to read
+     * @param frequencies Receives the frequency bins in Hz
+     * @param magnitudes Receives the magnitude values in dB
+     * @param phases Receives the phase values in degrees
+     * @return True if the file was read successfully
+     */
+    bool readCSV(const fs::path&      filePath,
+                 std::vector<double>& frequencies,
+                 std::vector<double>& magnitudes,
+                 std::vector<double>& phases);
+
     /**
      * @brief Writes a CSV file with waveform time-domain data
      * @param filePath Path to the CSV file to write
@@ -67,6 +105,254 @@ namespace utils
      */
     bool exportWAV(const fs::path& filePath, const std::vector<float>& samples, double sampleRate);
 
+    /**
+     * @brief Buffered CSV writer for large tables
+     *
+     * Numbers are formatted with std::to_chars into a large reusable buffer that is handed to
+     * the file in big chunks, instead of going through iostream formatting and a flush per row.
+     * Optionally a background thread performs the file writes while the caller keeps formatting
+     * into a second buffer. Values are formatted exactly like the iostream defaults the CSV
+     * schemas were defined with, so output is byte-identical to the previous writers.
+     */
+    class CSVStreamWriter
+    {
+    public:
+        CSVStreamWriter() = default;
+        ~CSVStreamWriter();
+
+        CSVStreamWriter(const CSVStreamWriter&)            = delete;
+        CSVStreamWriter& operator=(const CSVStreamWriter&) = delete;
+
+        /**
+         * @brief Creates the file and writes the header line
+         * @param filePath Path to the CSV file to write
+         * @param headers Comma-separated column headers
+         * @param backgroundWrites Perform file writes on a dedicated writer thread
+         * @return True if the file was opened successfully
+         */
+        bool open(const fs::path& filePath, const std::string& headers, bool backgroundWrites = false);
+
+        /**
+         * @brief Appends a chunk of rows formatted like the default iostream output (6 significant digits)
+         * @param timePoints Time values in seconds (first column)
+         * @param columns Pointers to the remaining columns, each holding numRows values
+         * @param numColumns Number of entries in columns
+         * @param numRows Number of rows to append
+         * @return True if the rows were written successfully
+         */
+        bool writeRows(const float* timePoints, const float* const* columns, size_t numColumns, size_t numRows);
+
+        /**
+         * @brief Appends a chunk of rows in fixed notation (like std::fixed with std::setprecision)
+         * @param columns Pointers to the columns, each holding numRows values
+         * @param numColumns Number of entries in columns
+         * @param numRows Number of rows to append
+         * @param decimals Number of digits after the decimal point
+         * @return True if the rows were written successfully
+         */
+        bool writeFixedRows(const double* const* columns, size_t numColumns, size_t numRows, int decimals);
+
+        /**
+         * @brief Writes any buffered data and closes the file
+         * @return True if all data reached the file
+         */
+        bool close();
+
+        bool isOpen() const { return file.is_open(); }
+
+    private:
+        static constexpr size_t bufferCapacity = 1 << 20;
+
+        void ensureSpace(size_t numBytes);
+        void submitBuffer();
+        void writerLoop();
+
+        std::ofstream     file;
+        fs::path          path;
+        std::vector<char> buffer;
+        size_t            used = 0;
+
+        // Background writer: `pending` is owned by the writer thread while hasPending is set
+        std::thread             writerThread;
+        std::mutex              writerMutex;
+        std::condition_variable writerCondition;
+        std::vector<char>       pending;
+        size_t                  pendingSize = 0;
+        bool                    hasPending  = false;
+        bool                    stopWriter  = false;
+        std::atomic<bool>       writeFailed{false};
+    };
+
+    /**
+     * @brief Writes a NumPy .npy file incrementally
+     *
+     * The array is one-dimensional with a structured dtype holding one named field per column
+     * (the CSV header names), little-endian and C-contiguous, so NumPy can memory-map it directly
+     * with np.load(path, mmap_mode="r") and pandas can wrap it with pd.DataFrame(array).
+     * The shape is patched on close(), so the number of rows does not need to be known up front.
+     */
+    class NpyStreamWriter
+    {
+    public:
+        enum class DType
+        {
+            Float32,
+            Float64
+        };
+
+        NpyStreamWriter() = default;
+        ~NpyStreamWriter();
+
+        NpyStreamWriter(const NpyStreamWriter&)            = delete;
+        NpyStreamWriter& operator=(const NpyStreamWriter&) = delete;
+
+        /**
+         * @brief Creates the file and writes a provisional header
+         * @param filePath Path to the .npy file to write
+         * @param fieldNames Name of every column, in row order
+         * @param dtype Storage type of every column
+         * @return True if the file was opened successfully
+         */
+        bool open(const fs::path& filePath, const std::vector<std::string>& fieldNames, DType dtype);
+
+        /**
+         * @brief Appends a chunk of rows
+         * @param columns One pointer per field, each holding numRows values
+         * @param numRows Number of rows to append
+         * @return True if the rows were written successfully
+         */
+        bool writeRows(const float* const* columns, size_t numRows);
+
+        /**
+         * @brief Appends a chunk of rows
+         * @param columns One pointer per field, each holding numRows values
+         * @param numRows Number of rows to append
+         * @return True if the rows were written successfully
+         */
+        bool writeRows(const double* const* columns, size_t numRows);
+
+        /**
+         * @brief Patches the shape in the header and closes the file
+         * @return True if the file was finalized successfully
+         */
+        bool close();
+
+        bool isOpen() const { return file.is_open(); }
+
+    private:
+        template <typename SourceType>
+        bool writeRowsImpl(const SourceType* const* columns, size_t numRows);
+
+        std::string buildHeader(uint64_t numRows) const;
+
+        std::ofstream            file;
+        fs::path                 path;
+        std::vector<std::string> fields;
+        DType                    storageType    = DType::Float64;
+        size_t                   headerSize     = 0;
+        uint64_t                 numRowsWritten = 0;
+        std::vector<char>        buffer;
+    };
+
+    /**
+     * @brief Writes a frequency response as a NumPy .npy file
+     *
+     * Same column semantics as writeCSV(): fields frequency_hz, magnitude_db and phase_degrees.
+     * @param filePath Path to the .npy file to write
+     * @param frequencies Vector of frequency bins in Hz
+     * @param magnitudes Vector of magnitude values in dB (normalized to 0 dB peak)
+     * @param phases Vector of phase values in degrees (unwrapped)
+     * @return True if the file was written successfully
+     */
+    bool writeNpy(const fs::path&            filePath,
+                  const std::vector<double>& frequencies,
+                  const std::vector<double>& magnitudes,
+                  const std::vector<double>& phases);
+
+    /**
+     * @brief Streaming WAV writer for 16/24-bit PCM and 32-bit float
+     *
+     * Frames are converted and written in bounded chunks, so memory use does not depend on the
+     * file length. The header is written with placeholder sizes on open() and patched on close():
+     * files whose data exceeds the 4 GB RIFF limit are promoted to RF64 in place, using the JUNK
+     * chunk reserved for the ds64 sizes (EBU Tech 3306). Float to PCM conversion runs over whole
+     * chunks in branch-free loops the compiler can vectorize, with optional TPDF dither.
+     */
+    class WAVStreamWriter
+    {
+    public:
+        enum class SampleFormat
+        {
+            PCM16,
+            PCM24,
+            Float32
+        };
+
+        WAVStreamWriter() = default;
+        ~WAVStreamWriter();
+
+        WAVStreamWriter(const WAVStreamWriter&)            = delete;
+        WAVStreamWriter& operator=(const WAVStreamWriter&) = delete;
+
+        /**
+         * @brief Creates the file and writes a provisional header
+         * @param filePath Path to the WAV file to write
+         * @param sampleRate Sample rate in Hz
+         * @param numChannels Number of channels per frame
+         * @param format Sample format stored in the file
+         * @param dither Add TPDF dither before quantizing to PCM (ignored for Float32)
+         * @return True if the file was opened successfully
+         */
+        bool open(const fs::path& filePath,
+                  double          sampleRate,
+                  int             numChannels = 1,
+                  SampleFormat    format      = SampleFormat::PCM16,
+                  bool            dither      = false);
+
+        /**
+         * @brief Converts and appends interleaved frames
+         * @param samples Interleaved audio samples in [-1, 1] (PCM values outside are clipped)
+         * @param numFrames Number of frames to append (numFrames * numChannels samples)
+         * @return True if the samples were written successfully
+         */
+        bool write(const float* samples, size_t numFrames);
+
+        /**
+         * @brief Converts and appends non-interleaved frames
+         * @param channelData One pointer per channel, each holding numFrames samples
+         * @param numFrames Number of frames to append
+         * @return True if the samples were written successfully
+         */
+        bool write(const float* const* channelData, size_t numFrames);
+
+        /**
+         * @brief Patches the header sizes (promoting to RF64 if needed) and closes the file
+         * @return True if the file was finalized successfully
+         */
+        bool close();
+
+        bool isOpen() const { return file.is_open(); }
+
+    private:
+        static constexpr size_t chunkFrames = 16384;
+
+        std::vector<char> buildHeader(uint64_t dataBytes, bool rf64) const;
+        bool              writeInterleavedChunk(const float* samples, size_t numSamples);
+
+        std::ofstream        file;
+        fs::path             path;
+        SampleFormat         sampleFormat = SampleFormat::PCM16;
+        bool                 useDither    = false;
+        uint16_t             channels     = 1;
+        uint32_t             rate         = 48000;
+        uint64_t             dataBytes    = 0;
+        uint32_t             ditherState  = 0x9E3779B9u;
+        std::vector<float>   interleaveBuffer;
+        std::vector<float>   scaledBuffer;
+        std::vector<int32_t> intBuffer;
+        std::vector<char>    byteBuffer;
+    };
+
     /**
      * @brief Generates a filename for a filter's frequency response
      * @param filterType The type of filter (LowPass, HighPass, BandPass)
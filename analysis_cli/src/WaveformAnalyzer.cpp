@@ -1,80 +1,151 @@
-#include <juce_audio_basics/juce_audio_basics.h>
 #include <DiodeClipper/WDFDiodeClipper.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "MappedWAVReader.h"
 #include "Utils.h"
+#include "WorkStealingPool.h"
+#include "wdf_core/MathConstants.h"
 
 /**
- * @brief Generate a sine wave signal
+ * @brief Generate one chunk of a sine wave signal
+ * @param dest Destination buffer holding at least numSamples values
+ * @param firstSample Index of the first sample of the chunk within the whole signal
+ * @param numSamples Number of samples to generate
  * @param frequency Frequency in Hz
  * @param amplitude Peak amplitude
- * @param duration Duration in seconds
  * @param sampleRate Sample rate in Hz
- * @return Vector of samples
  */
-static std::vector<float> generateSineWave(float frequency, float amplitude, float duration, float sampleRate)
+static void generateSineChunk(
+    float* dest, uint64_t firstSample, size_t numSamples, float frequency, float amplitude, float sampleRate)
 {
-    const int          numSamples = static_cast<int>(duration * sampleRate);
-    std::vector<float> signal(numSamples, 0.0f);
+    // Phase is evaluated in double so hour-long signals do not drift once the
+    // sample index exceeds float precision.
+    const double omega = 2.0 * wdf_core::MathConstants<double>::pi * frequency;
 
-    const float omega = 2.0f * juce::MathConstants<float>::pi * frequency;
-
-    for (int i = 0; i < numSamples; ++i)
+    for (size_t i = 0; i < numSamples; ++i)
     {
-        const float time = static_cast<float>(i) / sampleRate;
-        signal[i]        = amplitude * std::sin(omega * time);
+        const double time = static_cast<double>(firstSample + i) / sampleRate;
+        dest[i]           = amplitude * static_cast<float>(std::sin(omega * time));
     }
-
-    return signal;
 }
 
 /**
- * @brief Process a signal through the DiodeClipper
- * @param inputSignal Input signal vector
+ * @brief Fill one chunk of time points
+ * @param dest Destination buffer holding at least numSamples values
+ * @param firstSample Index of the first sample of the chunk within the whole signal
+ * @param numSamples Number of time points to generate
  * @param sampleRate Sample rate in Hz
- * @param cutoffFreq Cutoff frequency for the clipper
- * @param diodeIs Diode saturation current
- * @param numDiodes Number of diodes in series
- * @return Processed signal
  */
-static std::vector<float> processSignalThroughDiodeClipper(
-    const std::vector<float>& inputSignal, float sampleRate, float cutoffFreq, float diodeIs, float numDiodes)
+static void fillTimePoints(float* dest, uint64_t firstSample, size_t numSamples, float sampleRate)
 {
-    // Create and prepare the DiodeClipper
-    WDFDiodeClipperJUCE diodeClipper;
-    diodeClipper.prepare(sampleRate);
-    diodeClipper.setParameters(cutoffFreq, diodeIs, numDiodes, true); // force parameters immediately
-
-    // Process each sample
-    std::vector<float> outputSignal(inputSignal.size());
-    for (size_t i = 0; i < inputSignal.size(); ++i)
-    {
-        outputSignal[i] = diodeClipper.processSample(inputSignal[i]);
-    }
-
-    return outputSignal;
+    for (size_t i = 0; i < numSamples; ++i)
+        dest[i] = static_cast<float>(static_cast<double>(firstSample + i) / sampleRate);
 }
 
 /**
- * @brief Create time points vector for the given number of samples and sample rate
- * @param numSamples Number of samples
- * @param sampleRate Sample rate in Hz
- * @return Vector of time points in seconds
+ * @brief Reusable storage for one chunk of the analysis
+ *
+ * Three of these rotate through the pipeline: while the clipper processes one, the pool
+ * writes the previous one to disk and fills the next one with input.
  */
-static std::vector<float> createTimePoints(size_t numSamples, float sampleRate)
+struct WaveformChunk
 {
-    std::vector<float> timePoints(numSamples);
-    for (size_t i = 0; i < numSamples; ++i)
+    std::vector<float> timePoints;
+    std::vector<float> input;
+    std::vector<float> output;
+    size_t             numSamples = 0;
+};
+
+/**
+ * @brief Set of output files receiving the streamed analysis
+ */
+struct WaveformSinks
+{
+    utils::CSVStreamWriter inputCSV;
+    utils::CSVStreamWriter outputCSV;
+    utils::CSVStreamWriter comparisonCSV;
+    utils::NpyStreamWriter inputNpy;
+    utils::NpyStreamWriter outputNpy;
+    utils::NpyStreamWriter comparisonNpy;
+    utils::WAVStreamWriter inputWAV;
+    utils::WAVStreamWriter outputWAV;
+
+    /**
+     * @brief Queues the writes of one chunk, one task per open file
+     *
+     * Each file only ever receives one task per chunk, so the files are written in parallel while
+     * every file still gets its chunks in order, as long as a chunk's tasks finish before the next
+     * chunk's are queued.
+     * @param pool Pool the writes run on
+     * @param chunk Chunk to write; must stay untouched until the tasks have finished
+     * @param ok Cleared by any write that fails
+     */
+    void submitWrite(utils::WorkStealingPool& pool, const WaveformChunk& chunk, std::atomic<bool>& ok)
     {
-        timePoints[i] = static_cast<float>(i) / sampleRate;
+        const auto submit = [&pool, &ok](auto write) {
+            pool.submit([write, &ok](int) {
+                if (!write())
+                    ok = false;
+            });
+        };
+
+        if (inputCSV.isOpen())
+        {
+            submit([this, &chunk] {
+                const float* column[] = {chunk.input.data()};
+                return inputCSV.writeRows(chunk.timePoints.data(), column, 1, chunk.numSamples);
+            });
+            submit([this, &chunk] {
+                const float* column[] = {chunk.output.data()};
+                return outputCSV.writeRows(chunk.timePoints.data(), column, 1, chunk.numSamples);
+            });
+            submit([this, &chunk] {
+                const float* columns[] = {chunk.input.data(), chunk.output.data()};
+                return comparisonCSV.writeRows(chunk.timePoints.data(), columns, 2, chunk.numSamples);
+            });
+        }
+
+        if (inputNpy.isOpen())
+        {
+            submit([this, &chunk] {
+                const float* fields[] = {chunk.timePoints.data(), chunk.input.data()};
+                return inputNpy.writeRows(fields, chunk.numSamples);
+            });
+            submit([this, &chunk] {
+                const float* fields[] = {chunk.timePoints.data(), chunk.output.data()};
+                return outputNpy.writeRows(fields, chunk.numSamples);
+            });
+            submit([this, &chunk] {
+                const float* fields[] = {chunk.timePoints.data(), chunk.input.data(), chunk.output.data()};
+                return comparisonNpy.writeRows(fields, chunk.numSamples);
+            });
+        }
+
+        if (inputWAV.isOpen())
+            submit([this, &chunk] { return inputWAV.write(chunk.input.data(), chunk.numSamples); });
+        if (outputWAV.isOpen())
+            submit([this, &chunk] { return outputWAV.write(chunk.output.data(), chunk.numSamples); });
     }
-    return timePoints;
+};
+
+/**
+ * @brief Replace the extension of a generated filename
+ * @param filename Filename ending in .csv
+ * @param extension New extension including the dot
+ * @return The filename with the new extension
+ */
+static std::string withExtension(const std::string& filename, const char* extension)
+{
+    return fs::path(filename).replace_extension(extension).string();
 }
 
 int main(int argc, char* argv[])
@@ -88,6 +159,12 @@ int main(int argc, char* argv[])
     float diodeIs    = 2.52e-9f; // Default diode saturation current
     float numDiodes  = 2.0f;     // Default number of diodes in series
     bool  exportWav  = false;    // Default to CSV only
+    int   chunkSize  = 65536;    // Samples generated, processed and written per step
+    int   numThreads = 0;        // Workers filling and writing chunks (0: hardware concurrency)
+
+    fs::path inputFile; // Process channel 0 of this WAV file instead of a sine
+
+    utils::OutputFormat format = utils::OutputFormat::CSV;
 
     // Parse command line arguments
     for (int i = 1; i < argc; ++i)
@@ -109,6 +186,20 @@ int main(int argc, char* argv[])
             numDiodes = std::stof(argv[++i]);
         else if (arg == "--wav")
             exportWav = true;
+        else if (arg == "--input" && i + 1 < argc)
+            inputFile = argv[++i];
+        else if (arg == "--chunk" && i + 1 < argc)
+            chunkSize = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--threads" && i + 1 < argc)
+            numThreads = std::stoi(argv[++i]);
+        else if (arg == "--format" && i + 1 < argc)
+        {
+            if (!utils::parseOutputFormat(argv[++i], format))
+            {
+                std::cerr << "Unknown output format: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
         else if (arg == "--help")
         {
             std::cout << "Usage: WaveformAnalyzer [options]" << std::endl
@@ -121,6 +212,10 @@ int main(int argc, char* argv[])
                       << "  --is <value>       Diode saturation current (default: 2.52e-9)" << std::endl
                       << "  --diodes <value>   Number of diodes in series (default: 2.0)" << std::endl
                       << "  --wav              Export WAV files in addition to CSV" << std::endl
+                      << "  --input <file>     Process the first channel of a WAV file instead of a sine" << std::endl
+                      << "  --chunk <samples>  Samples per streaming chunk (default: 65536)" << std::endl
+                      << "  --threads <n>      Worker threads (default: hardware concurrency)" << std::endl
+                      << "  --format <fmt>     Table format: csv, npy or both (default: csv)" << std::endl
                       << "  --help             Show this help message" << std::endl;
             return 0;
         }
@@ -137,50 +232,187 @@ int main(int argc, char* argv[])
     std::cout << "Generating waveform analysis for DiodeClipper..." << std::endl;
     std::cout << "Output directory: " << outputDir.string() << std::endl;
 
-    // Generate the sine wave
-    std::vector<float> inputSignal = generateSineWave(frequency, amplitude, duration, sampleRate);
-
-    // Process through DiodeClipper
-    std::vector<float> outputSignal =
-        processSignalThroughDiodeClipper(inputSignal, sampleRate, cutoffFreq, diodeIs, numDiodes);
+    // The input file is memory-mapped and converted chunk by chunk, so its length is not bounded by RAM
+    utils::MappedWAVReader reader;
+    uint64_t               totalSamples = static_cast<uint64_t>(static_cast<double>(duration) * sampleRate);
+    if (!inputFile.empty())
+    {
+        if (!reader.open(inputFile))
+            return 1;
 
-    // Create time points
-    std::vector<float> timePoints = createTimePoints(inputSignal.size(), sampleRate);
+        sampleRate   = static_cast<float>(reader.getSampleRate());
+        totalSamples = reader.getNumFrames();
+        std::cout << "Input file: " << inputFile.string() << std::endl;
+    }
 
     // Generate parameter string for filename
     std::string paramStr = "cutoff" + std::to_string(static_cast<int>(cutoffFreq)) + "_diodes" +
                            std::to_string(static_cast<int>(numDiodes));
+    std::string signalStr = inputFile.empty() ? "Sine_" + std::to_string(static_cast<int>(frequency)) + "Hz"
+                                              : inputFile.stem().string();
+
+    std::string inputFilename     = "Input_" + signalStr + "_" + paramStr + ".csv";
+    std::string outputFilename    = "DiodeClipper_" + signalStr + "_" + paramStr + ".csv";
+    std::string compFilename      = "Comparison_" + signalStr + "_" + paramStr + ".csv";
+    std::string inputWavFilename  = "Input_" + signalStr + "_" + paramStr + ".wav";
+    std::string outputWavFilename = "DiodeClipper_" + signalStr + "_" + paramStr + ".wav";
+
+    // Open every sink up front; the signal is then streamed through them chunk by chunk
+    const bool writeCSV = format != utils::OutputFormat::Npy;
+    const bool writeNpy = format != utils::OutputFormat::CSV;
+
+    WaveformSinks sinks;
+    bool          opened = true;
+    if (writeCSV)
+        opened = sinks.inputCSV.open(outputDir / inputFilename, "Time (s),Amplitude", true) &&
+                 sinks.outputCSV.open(outputDir / outputFilename, "Time (s),Amplitude", true) &&
+                 sinks.comparisonCSV.open(
+                     outputDir / compFilename, "Time (s),Input Amplitude,Output Amplitude", true);
+    if (opened && writeNpy)
+        opened = sinks.inputNpy.open(outputDir / withExtension(inputFilename, ".npy"),
+                                     {"Time (s)", "Amplitude"},
+                                     utils::NpyStreamWriter::DType::Float32) &&
+                 sinks.outputNpy.open(outputDir / withExtension(outputFilename, ".npy"),
+                                      {"Time (s)", "Amplitude"},
+                                      utils::NpyStreamWriter::DType::Float32) &&
+                 sinks.comparisonNpy.open(outputDir / withExtension(compFilename, ".npy"),
+                                          {"Time (s)", "Input Amplitude", "Output Amplitude"},
+                                          utils::NpyStreamWriter::DType::Float32);
+    if (opened && exportWav)
+        opened = sinks.inputWAV.open(outputDir / inputWavFilename, sampleRate) &&
+                 sinks.outputWAV.open(outputDir / outputWavFilename, sampleRate);
+    if (!opened)
+    {
+        std::cerr << "Failed to open output files" << std::endl;
+        return 1;
+    }
+
+    // Create and prepare the DiodeClipper once; its state carries across chunks
+    WDFDiodeClipperJUCE diodeClipper;
+    diodeClipper.prepare(sampleRate);
+    diodeClipper.setParameters(cutoffFreq, diodeIs, numDiodes, true); // force parameters immediately
+
+    const size_t maxChunk = static_cast<size_t>(chunkSize);
+
+    WaveformChunk chunks[3];
+    for (auto& chunk : chunks)
+    {
+        chunk.timePoints.resize(maxChunk);
+        chunk.input.resize(maxChunk);
+        chunk.output.resize(maxChunk);
+    }
+
+    utils::WorkStealingPool pool(numThreads);
+    const size_t            numWorkers = static_cast<size_t>(pool.getNumWorkers());
+
+    // Only the first channel of the input file is converted; the others stay untouched in the mapping.
+    // Each worker has its own pointer array, so slices of a chunk can be read concurrently.
+    const size_t                     numFileChannels = static_cast<size_t>(std::max(1, reader.getNumChannels()));
+    std::vector<std::vector<float*>> readPointers(numWorkers, std::vector<float*>(numFileChannels, nullptr));
+
+    // Input and time points of a chunk are generated in one slice per worker
+    const auto submitFill = [&](WaveformChunk& chunk, uint64_t position) {
+        chunk.numSamples       = static_cast<size_t>(std::min<uint64_t>(maxChunk, totalSamples - position));
+        const size_t sliceSize = std::max<size_t>(4096, (chunk.numSamples + numWorkers - 1) / numWorkers);
+
+        for (size_t offset = 0; offset < chunk.numSamples; offset += sliceSize)
+        {
+            const size_t   length = std::min(sliceSize, chunk.numSamples - offset);
+            const uint64_t first  = position + offset;
+            pool.submit([&, first, offset, length](int workerIndex) {
+                if (reader.isOpen())
+                {
+                    std::vector<float*>& pointers = readPointers[static_cast<size_t>(workerIndex)];
+                    pointers[0]                   = chunk.input.data() + offset;
+                    reader.readFrames(first, length, pointers.data());
+                }
+                else
+                    generateSineChunk(chunk.input.data() + offset, first, length, frequency, amplitude, sampleRate);
+                fillTimePoints(chunk.timePoints.data() + offset, first, length, sampleRate);
+            });
+        }
+    };
+
+    // Pipeline: while this thread runs the clipper over one chunk (its state makes it sequential),
+    // the pool writes the previous chunk and fills the next one. Waiting for the pool at the end of
+    // every step keeps each file's chunks in order.
+    std::atomic<bool> writeOk{true};
+    WaveformChunk*    writing  = nullptr;
+    WaveformChunk*    clipping = &chunks[0];
+    WaveformChunk*    filling  = &chunks[1];
+    WaveformChunk*    spare    = &chunks[2];
+
+    uint64_t position = 0;
+    if (totalSamples > 0)
+    {
+        submitFill(*clipping, 0);
+        pool.wait();
+    }
 
-    // Export input signal
-    std::string inputFilename = utils::generateWaveformFilename("Input", "Sine", frequency, paramStr);
-    utils::writeWaveformCSV(outputDir / inputFilename, timePoints, inputSignal);
-    std::cout << "Generated " << inputFilename << std::endl;
+    while (position < totalSamples)
+    {
+        const uint64_t next = position + clipping->numSamples;
+        if (writing != nullptr)
+            sinks.submitWrite(pool, *writing, writeOk);
+        if (next < totalSamples)
+            submitFill(*filling, next);
+
+        for (size_t i = 0; i < clipping->numSamples; ++i)
+            clipping->output[i] = diodeClipper.processSample(clipping->input[i]);
+
+        pool.wait();
+
+        // Rotate: the chunk just written is free to be filled next
+        if (writing != nullptr)
+            spare = writing;
+        writing  = clipping;
+        clipping = filling;
+        filling  = spare;
+        position = next;
+    }
+
+    if (writing != nullptr)
+    {
+        sinks.submitWrite(pool, *writing, writeOk);
+        pool.wait();
+    }
+
+    for (const auto& filename : {inputFilename, outputFilename, compFilename})
+    {
+        if (writeCSV)
+            std::cout << "Generated " << filename << std::endl;
+        if (writeNpy)
+            std::cout << "Generated " << withExtension(filename, ".npy") << std::endl;
+    }
 
-    // Export output signal
-    std::string outputFilename = utils::generateWaveformFilename("DiodeClipper", "Sine", frequency, paramStr);
-    utils::writeWaveformCSV(outputDir / outputFilename, timePoints, outputSignal);
-    std::cout << "Generated " << outputFilename << std::endl;
+    if (writeCSV)
+    {
+        writeOk = sinks.inputCSV.close() && writeOk;
+        writeOk = sinks.outputCSV.close() && writeOk;
+        writeOk = sinks.comparisonCSV.close() && writeOk;
+    }
 
-    // Export comparison CSV (input vs output)
-    std::string compFilename =
-        "Comparison_Sine_" + std::to_string(static_cast<int>(frequency)) + "Hz_" + paramStr + ".csv";
-    utils::writeComparisonCSV(outputDir / compFilename, timePoints, inputSignal, outputSignal);
-    std::cout << "Generated " << compFilename << std::endl;
+    if (writeNpy)
+    {
+        writeOk = sinks.inputNpy.close() && writeOk;
+        writeOk = sinks.outputNpy.close() && writeOk;
+        writeOk = sinks.comparisonNpy.close() && writeOk;
+    }
 
-    // Optionally export WAV files
     if (exportWav)
     {
-        std::string inputWavFilename =
-            "Input_Sine_" + std::to_string(static_cast<int>(frequency)) + "Hz_" + paramStr + ".wav";
-        utils::exportWAV(outputDir / inputWavFilename, inputSignal, sampleRate);
+        writeOk = sinks.inputWAV.close() && writeOk;
+        writeOk = sinks.outputWAV.close() && writeOk;
         std::cout << "Generated " << inputWavFilename << std::endl;
-
-        std::string outputWavFilename =
-            "DiodeClipper_Sine_" + std::to_string(static_cast<int>(frequency)) + "Hz_" + paramStr + ".wav";
-        utils::exportWAV(outputDir / outputWavFilename, outputSignal, sampleRate);
         std::cout << "Generated " << outputWavFilename << std::endl;
     }
 
+    if (!writeOk)
+    {
+        std::cerr << "Failed to write waveform analysis output" << std::endl;
+        return 1;
+    }
+
     std::cout << "Waveform analysis complete." << std::endl;
 
     return 0;
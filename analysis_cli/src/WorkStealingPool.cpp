@@ -0,0 +1,135 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+namespace utils
+{
+
+    WorkStealingPool::WorkStealingPool(int numThreads)
+    {
+        if (numThreads <= 0)
+            numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            workers.push_back(std::make_unique<Worker>());
+            workers.back()->tasks.resize(initialDequeCapacity);
+        }
+
+        for (int i = 0; i < numThreads; ++i)
+            threads.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    WorkStealingPool::~WorkStealingPool()
+    {
+        wait();
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stopping = true;
+        }
+        wakeCondition.notify_all();
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    void WorkStealingPool::push(Task&& task)
+    {
+        const size_t index = nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+        pendingTasks.fetch_add(1, std::memory_order_relaxed);
+        queuedTasks.fetch_add(1, std::memory_order_release);
+        {
+            Worker&                     worker = *workers[index];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+
+            // Full: grow once, unrolling the ring so the oldest task is at the front again
+            if (worker.count == worker.tasks.size())
+            {
+                std::vector<Task> grown(2 * worker.tasks.size());
+                for (size_t i = 0; i < worker.count; ++i)
+                    grown[i] = std::move(worker.tasks[(worker.head + i) % worker.tasks.size()]);
+                worker.tasks = std::move(grown);
+                worker.head  = 0;
+            }
+
+            worker.tasks[(worker.head + worker.count) % worker.tasks.size()] = std::move(task);
+            ++worker.count;
+        }
+
+        // Taking the state mutex pairs with the sleeping workers' predicate check, so a worker
+        // can't miss this wake-up between testing the counter and going to sleep
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+        }
+        wakeCondition.notify_one();
+    }
+
+    void WorkStealingPool::wait()
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        idleCondition.wait(lock, [this] { return pendingTasks.load(std::memory_order_acquire) == 0; });
+    }
+
+    bool WorkStealingPool::tryPop(int workerIndex, Task& task)
+    {
+        const size_t numWorkers = workers.size();
+
+        // Own deque first, newest task
+        {
+            Worker&                     own = *workers[static_cast<size_t>(workerIndex)];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.count > 0)
+            {
+                --own.count;
+                task = std::move(own.tasks[(own.head + own.count) % own.tasks.size()]);
+                return true;
+            }
+        }
+
+        // Then steal the oldest task from the other workers
+        for (size_t offset = 1; offset < numWorkers; ++offset)
+        {
+            Worker&                     victim = *workers[(static_cast<size_t>(workerIndex) + offset) % numWorkers];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.count > 0)
+            {
+                task        = std::move(victim.tasks[victim.head]);
+                victim.head = (victim.head + 1) % victim.tasks.size();
+                --victim.count;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void WorkStealingPool::workerLoop(int workerIndex)
+    {
+        Task task;
+        for (;;)
+        {
+            if (tryPop(workerIndex, task))
+            {
+                queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+                task(workerIndex);
+                task.clear(); // release the captures before the task counts as finished
+
+                if (pendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    std::lock_guard<std::mutex> lock(stateMutex);
+                    idleCondition.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wakeCondition.wait(lock,
+                               [this] { return stopping || queuedTasks.load(std::memory_order_acquire) > 0; });
+            if (stopping && queuedTasks.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+} // namespace utils
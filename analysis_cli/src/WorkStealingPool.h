@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utils
+{
+
+    /**
+     * @brief Work-stealing thread pool shared by the analysis tools
+     *
+     * Every worker owns a task deque. A worker pops its own tasks from the back (most recently
+     * queued, still warm in cache) and, once it runs dry, steals from the front of the other
+     * workers' deques. Tasks receive the index of the worker running them, so callers can keep
+     * one engine instance per worker instead of sharing state between threads.
+     *
+     * Queuing a task does not allocate: the callable is stored inline in the task (up to
+     * Task::capacity bytes of captures), and each deque is a ring buffer that only grows when more
+     * tasks are queued at once than ever before. After the first batch of a given size, a tool
+     * can submit and run any number of batches without touching the heap.
+     */
+    class WorkStealingPool
+    {
+    public:
+        /**
+         * @brief Type-erased callable invoked with the worker index, stored without allocating
+         */
+        class Task
+        {
+        public:
+            static constexpr size_t capacity = 128; // bytes of captured state
+
+            Task() = default;
+
+            template <typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, Task>>>
+            explicit Task(Callable&& callable)
+            {
+                using Stored = std::decay_t<Callable>;
+                static_assert(sizeof(Stored) <= capacity,
+                              "Task captures too much state; capture large objects by reference or pointer");
+                static_assert(alignof(Stored) <= alignof(std::max_align_t), "Task captures over-aligned state");
+                static_assert(std::is_nothrow_move_constructible_v<Stored>, "Task captures must be nothrow movable");
+
+                new (storage) Stored(std::forward<Callable>(callable));
+                invoke = [](void* self, int workerIndex) { (*static_cast<Stored*>(self))(workerIndex); };
+                manage = [](void* self, void* destination) {
+                    if (destination != nullptr)
+                        new (destination) Stored(std::move(*static_cast<Stored*>(self)));
+                    static_cast<Stored*>(self)->~Stored();
+                };
+            }
+
+            Task(Task&& other) noexcept { moveFrom(other); }
+
+            Task& operator=(Task&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    clear();
+                    moveFrom(other);
+                }
+                return *this;
+            }
+
+            Task(const Task&)            = delete;
+            Task& operator=(const Task&) = delete;
+
+            ~Task() { clear(); }
+
+            void operator()(int workerIndex) { invoke(storage, workerIndex); }
+
+            explicit operator bool() const { return invoke != nullptr; }
+
+            /**
+             * @brief Destroys the stored callable, releasing what it captured
+             */
+            void clear()
+            {
+                if (manage != nullptr)
+                    manage(storage, nullptr);
+                invoke = nullptr;
+                manage = nullptr;
+            }
+
+        private:
+            void moveFrom(Task& other)
+            {
+                if (other.manage != nullptr)
+                    other.manage(other.storage, storage);
+                invoke       = other.invoke;
+                manage       = other.manage;
+                other.invoke = nullptr;
+                other.manage = nullptr;
+            }
+
+            alignas(std::max_align_t) unsigned char storage[capacity];
+            void (*invoke)(void* self, int workerIndex)   = nullptr;
+            void (*manage)(void* self, void* destination) = nullptr; // moves into destination (if any) and destroys
+        };
+
+        /**
+         * @brief Starts the worker threads
+         * @param numThreads Number of workers (0 selects the hardware concurrency)
+         */
+        explicit WorkStealingPool(int numThreads = 0);
+
+        /**
+         * @brief Finishes the queued tasks and joins the workers
+         */
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&)            = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        /**
+         * @brief Queues a task, distributing tasks round-robin across the worker deques
+         * @param callable Callable invoked with the index of the worker that runs it; its captures must fit
+         *                 Task::capacity
+         */
+        template <typename Callable>
+        void submit(Callable&& callable)
+        {
+            push(Task(std::forward<Callable>(callable)));
+        }
+
+        /**
+         * @brief Blocks until every submitted task has finished
+         */
+        void wait();
+
+        /**
+         * @brief Gets the number of worker threads
+         * @return Number of workers
+         */
+        int getNumWorkers() const { return static_cast<int>(workers.size()); }
+
+    private:
+        // Ring buffer of tasks; the owner takes from the back, thieves from the front
+        struct Worker
+        {
+            std::mutex        mutex;
+            std::vector<Task> tasks;
+            size_t            head  = 0;
+            size_t            count = 0;
+        };
+
+        static constexpr size_t initialDequeCapacity = 256;
+
+        void push(Task&& task);
+        bool tryPop(int workerIndex, Task& task);
+        void workerLoop(int workerIndex);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::vector<std::thread>             threads;
+
+        std::mutex              stateMutex;
+        std::condition_variable wakeCondition;
+        std::condition_variable idleCondition;
+        std::atomic<size_t>     queuedTasks{0};   // submitted, not yet picked up
+        std::atomic<size_t>     pendingTasks{0};  // submitted, not yet finished
+        std::atomic<size_t>     nextWorker{0};
+        bool                    stopping = false;
+    };
+
+} // namespace utils
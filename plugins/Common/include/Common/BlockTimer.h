@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Set to 0 (CMake option WDF_ENABLE_BLOCK_TIMING=OFF) to compile the instrumentation out
+#ifndef WDF_ENABLE_BLOCK_TIMING
+#define WDF_ENABLE_BLOCK_TIMING 1
+#endif
+
+/**
+ * @brief Timing of one processBlock() call as recorded on the audio thread
+ */
+struct BlockTiming
+{
+    uint64_t startTicks    = 0; // timestamp counter at the start of the callback
+    uint32_t durationTicks = 0; // saturates at 2^32 - 1
+    uint32_t numSamples    = 0; // samples per channel processed in this callback
+};
+
+/**
+ * @brief Aggregated block timings, as returned by BlockTimer::collectStats()
+ */
+struct BlockTimingStats
+{
+    uint64_t numBlocks      = 0;
+    uint64_t numSamples     = 0;
+    uint64_t deadlineMisses = 0; // blocks that took longer than their real-time budget
+    uint64_t numDropped     = 0; // blocks lost because the reader did not keep up
+    double   minSeconds     = 0.0;
+    double   avgSeconds     = 0.0;
+    double   maxSeconds     = 0.0;
+    double   maxLoad        = 0.0; // worst duration divided by the block's real-time budget
+};
+
+/**
+ * @brief Per-block CPU instrumentation for plugin processors
+ *
+ * The audio thread wraps its callback in a BlockTimer::Scope, which reads the CPU
+ * timestamp counter twice and pushes one BlockTiming into a lock-free single-producer,
+ * single-consumer ring. A reader (the editor's timer, a test harness) drains the ring
+ * with pull() or collectStats(). The producer never blocks or allocates: when the ring
+ * is full the new entry is counted as dropped instead.
+ *
+ * With WDF_ENABLE_BLOCK_TIMING set to 0 the scope is empty and the reader reports nothing.
+ */
+class BlockTimer
+{
+public:
+    static constexpr size_t capacity = 1024; // must be a power of two
+
+    /**
+     * @brief Reads the timestamp counter (TSC on x86, CNTVCT on AArch64, steady_clock elsewhere)
+     * @return Current tick count
+     */
+    static uint64_t readTicks() noexcept
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t ticks;
+        __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+#endif
+    }
+
+    /**
+     * @brief Records one block on destruction
+     */
+    class Scope
+    {
+    public:
+#if WDF_ENABLE_BLOCK_TIMING
+        Scope(BlockTimer& timerToUse, int numSamplesInBlock) noexcept
+            : timer(timerToUse)
+            , numSamples(static_cast<uint32_t>(numSamplesInBlock))
+            , start(readTicks())
+        {}
+
+        ~Scope() noexcept { timer.push(start, readTicks() - start, numSamples); }
+
+    private:
+        BlockTimer&    timer;
+        const uint32_t numSamples;
+        const uint64_t start;
+#else
+        Scope(BlockTimer&, int) noexcept {}
+#endif
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * @brief Sets the real-time budget used to count deadline misses; call from prepareToPlay()
+     *
+     * On x86 the first call also measures the TSC rate by spinning for 10 ms, so this
+     * must not be called on the audio thread.
+     * @param newSampleRate Sample rate in Hz
+     * @param maximumBlockSize Largest block the host will pass to processBlock()
+     */
+    void prepare(double newSampleRate, int maximumBlockSize) noexcept
+    {
+        sampleRate.store(newSampleRate, std::memory_order_relaxed);
+        maxBlockSize.store(maximumBlockSize, std::memory_order_relaxed);
+#if WDF_ENABLE_BLOCK_TIMING && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+        if (!calibrated())
+            calibrate();
+#endif
+    }
+
+    double getSampleRate() const noexcept { return sampleRate.load(std::memory_order_relaxed); }
+    int    getMaximumBlockSize() const noexcept { return maxBlockSize.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Appends one entry; called on the audio thread only
+     * @param startTicks Timestamp at the start of the callback
+     * @param durationTicks Ticks spent in the callback
+     * @param numSamples Samples per channel processed
+     */
+    void push(uint64_t startTicks, uint64_t durationTicks, uint32_t numSamples) noexcept
+    {
+#if WDF_ENABLE_BLOCK_TIMING
+        const uint64_t write = writeIndex.load(std::memory_order_relaxed);
+        if (write - readIndex.load(std::memory_order_acquire) >= capacity)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        constexpr uint64_t maxDuration = std::numeric_limits<uint32_t>::max();
+
+        BlockTiming& entry  = ring[static_cast<size_t>(write) & (capacity - 1)];
+        entry.startTicks    = startTicks;
+        entry.durationTicks = static_cast<uint32_t>(std::min(durationTicks, maxDuration));
+        entry.numSamples    = numSamples;
+        writeIndex.store(write + 1, std::memory_order_release);
+#else
+        (void) startTicks;
+        (void) durationTicks;
+        (void) numSamples;
+#endif
+    }
+
+    /**
+     * @brief Moves pending entries out of the ring; called from a single reader thread
+     * @param destination Receives up to maxEntries timings, oldest first
+     * @param maxEntries Size of destination
+     * @return Number of entries written
+     */
+    size_t pull(BlockTiming* destination, size_t maxEntries) noexcept
+    {
+#if WDF_ENABLE_BLOCK_TIMING
+        const uint64_t read      = readIndex.load(std::memory_order_relaxed);
+        const uint64_t available = writeIndex.load(std::memory_order_acquire) - read;
+        const size_t   count     = static_cast<size_t>(std::min<uint64_t>(available, maxEntries));
+
+        for (size_t i = 0; i < count; ++i)
+            destination[i] = ring[static_cast<size_t>(read + i) & (capacity - 1)];
+
+        readIndex.store(read + count, std::memory_order_release);
+        return count;
+#else
+        (void) destination;
+        (void) maxEntries;
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Drains the ring and summarises the blocks recorded since the last call
+     * @param budgetFraction Fraction of a block's duration (numSamples / sampleRate) it may take
+     *                       before it counts as a deadline miss
+     * @return Statistics over the drained blocks; all zero if nothing was recorded
+     */
+    BlockTimingStats collectStats(double budgetFraction = 1.0) noexcept
+    {
+        BlockTimingStats stats;
+#if WDF_ENABLE_BLOCK_TIMING
+        stats.numDropped = dropped.exchange(0, std::memory_order_relaxed);
+
+        const double tickSeconds  = getSecondsPerTick();
+        const double rate         = getSampleRate();
+        double       totalSeconds = 0.0;
+        double       minSeconds   = std::numeric_limits<double>::max();
+
+        std::array<BlockTiming, 64> batch;
+        for (size_t n = pull(batch.data(), batch.size()); n > 0; n = pull(batch.data(), batch.size()))
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                const double seconds = static_cast<double>(batch[i].durationTicks) * tickSeconds;
+                totalSeconds += seconds;
+                minSeconds       = std::min(minSeconds, seconds);
+                stats.maxSeconds = std::max(stats.maxSeconds, seconds);
+                stats.numSamples += batch[i].numSamples;
+                ++stats.numBlocks;
+
+                if (rate > 0.0 && batch[i].numSamples > 0)
+                {
+                    const double load = seconds * rate / static_cast<double>(batch[i].numSamples);
+                    stats.maxLoad     = std::max(stats.maxLoad, load);
+                    if (load > budgetFraction)
+                        ++stats.deadlineMisses;
+                }
+            }
+        }
+
+        if (stats.numBlocks > 0)
+        {
+            stats.minSeconds = minSeconds;
+            stats.avgSeconds = totalSeconds / static_cast<double>(stats.numBlocks);
+        }
+#else
+        (void) budgetFraction;
+#endif
+        return stats;
+    }
+
+    /**
+     * @brief Converts ticks to seconds
+     *
+     * The x86 TSC rate is not exposed directly, so prepare() measures it against
+     * steady_clock. If prepare() has not been called yet, the reader measures it here
+     * instead. Called from the reader thread only.
+     * @return Duration of one tick in seconds
+     */
+    double getSecondsPerTick() noexcept
+    {
+#if WDF_ENABLE_BLOCK_TIMING && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+        if (!calibrated())
+            calibrate();
+        return secondsPerTick.load(std::memory_order_relaxed);
+#elif defined(__aarch64__)
+        uint64_t frequency;
+        __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+        return frequency > 0 ? 1.0 / static_cast<double>(frequency) : 1.0e-9;
+#else
+        return 1.0e-9;
+#endif
+    }
+
+private:
+#if WDF_ENABLE_BLOCK_TIMING
+    bool calibrated() const noexcept { return secondsPerTick.load(std::memory_order_relaxed) > 0.0; }
+
+    // Counts TSC ticks over a busy-wait of calibrationTime on steady_clock
+    void calibrate() noexcept
+    {
+        const auto     start      = std::chrono::steady_clock::now();
+        const uint64_t startTicks = readTicks();
+
+        auto now = start;
+        while (now - start < calibrationTime)
+            now = std::chrono::steady_clock::now();
+
+        const uint64_t ticks   = readTicks() - startTicks;
+        const double   elapsed = std::chrono::duration<double>(now - start).count();
+        secondsPerTick.store(ticks > 0 ? elapsed / static_cast<double>(ticks) : 1.0e-9, std::memory_order_relaxed);
+    }
+
+    static constexpr std::chrono::milliseconds calibrationTime{10};
+
+    // Indices only ever grow; a slot is index & (capacity - 1)
+    alignas(64) std::atomic<uint64_t> writeIndex{0};
+    alignas(64) std::atomic<uint64_t> readIndex{0};
+    std::atomic<uint64_t>             dropped{0};
+    std::array<BlockTiming, capacity> ring{};
+
+    std::atomic<double> secondsPerTick{0.0}; // written by calibrate() from prepare() or the reader thread
+#endif
+
+    std::atomic<double> sampleRate{0.0};
+    std::atomic<int>    maxBlockSize{0};
+
+    static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+};
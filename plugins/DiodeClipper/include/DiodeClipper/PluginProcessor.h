@@ -1,6 +1,7 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "Common/BlockTimer.h"
 #include "DiodeClipper/WDFDiodeClipper.h"
 #include <chowdsp_wdf/chowdsp_wdf.h>
 
@@ -44,6 +45,11 @@ public:
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
 
+    /**
+     * @brief Per-block timings of processBlock(), to be drained by the editor or a test harness
+     */
+    BlockTimer& getBlockTimer() noexcept { return blockTimer; }
+
     void updateParameters();
 
 private:
@@ -51,6 +57,7 @@ private:
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
     WDFDiodeClipperJUCE diodeClipper;
+    BlockTimer          blockTimer;
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioPluginAudioProcessor)
 };
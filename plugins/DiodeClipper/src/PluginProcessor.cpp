@@ -105,9 +105,8 @@ void AudioPluginAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
 {
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
-    juce::ignoreUnused(sampleRate, samplesPerBlock);
-
     diodeClipper.prepare(sampleRate);
+    blockTimer.prepare(sampleRate, samplesPerBlock);
 }
 
 void AudioPluginAudioProcessor::releaseResources()
@@ -151,18 +150,12 @@ void AudioPluginAudioProcessor::updateParameters()
 
 void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    BlockTimer::Scope timing(blockTimer, buffer.getNumSamples());
     juce::ignoreUnused(midiMessages);
     updateParameters();
 
     for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-    {
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            auto x = buffer.getSample(channel, i);
-            auto y = diodeClipper.processSample(x);
-            buffer.setSample(channel, i, y);
-        }
-    }
+        diodeClipper.processBlock(buffer.getWritePointer(channel), buffer.getNumSamples());
 }
 
 //==============================================================================
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "Common/BlockTimer.h"
 #include <chowdsp_wdf/chowdsp_wdf.h>
 
-#include "BandPassFilter.h"
-#include "HighPassFilter.h"
-#include "LowPassFilter.h"
+#include "WDFilters/BandPassFilter.h"
+#include "WDFilters/HighPassFilter.h"
+#include "WDFilters/LowPassFilter.h"
+#include "WDFilters/StateVariableFilter.h"
 
 //==============================================================================
 
@@ -48,6 +50,11 @@ public:
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
 
+    /**
+     * @brief Per-block timings of processBlock(), to be drained by the editor or a test harness
+     */
+    BlockTimer& getBlockTimer() noexcept { return blockTimer; }
+
 private:
     juce::AudioProcessorValueTreeState                  apvts;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
@@ -59,7 +66,13 @@ private:
     std::unique_ptr<WDFilter> highPass2;
     std::unique_ptr<WDFilter> bandPass1;
     std::unique_ptr<WDFilter> bandPass2;
+    std::unique_ptr<WDFilter> resonator; // single RLC band-pass, independent of the order
+    std::unique_ptr<WDFilter> svfLowPass; // state-variable engine, second order only
+    std::unique_ptr<WDFilter> svfHighPass;
+    std::unique_ptr<WDFilter> svfBandPass;
     WDFilter*                 currentFilter = nullptr;
+
+    BlockTimer blockTimer;
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioPluginAudioProcessor)
 };
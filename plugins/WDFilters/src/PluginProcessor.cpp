@@ -35,11 +35,22 @@ juce::AudioProcessorValueTreeState::ParameterLayout AudioPluginAudioProcessor::c
                                                            20.0f,
                                                            20000.0f,
                                                            1000.0f));
-    // layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{"bandwidth", 1},
-    //                                                        "Bandwidth (octaves)",
-    //                                                        0.1f,
-    //                                                        3.0f,
-    //                                                        1.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{"bandwidth", 1},
+                                                           "Bandwidth (octaves)",
+                                                           0.1f,
+                                                           3.0f,
+                                                           1.0f));
+    // Band Pass runs the RLC resonator instead of the RC cascade; a separate parameter, so that the filterType
+    // choices (and their normalised values in saved sessions) stay as they were
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{"resonator", 1},
+                                                          "Band Pass Resonator",
+                                                          false));
+    // WDF circuits, or the state-variable filter for heavily modulated tracks; appended last, so the host
+    // indices of the earlier parameters stay as they were
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{"engine", 1},
+                                                            "Engine",
+                                                            juce::StringArray{"WDF", "State Variable (TPT)"},
+                                                            0));
 
     return layout;
 }
@@ -112,7 +123,8 @@ void AudioPluginAudioProcessor::changeProgramName(int index, const juce::String&
 //==============================================================================
 void AudioPluginAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    juce::ignoreUnused(samplesPerBlock);
+    blockTimer.prepare(sampleRate, samplesPerBlock);
+
     // Create all possible filters upfront
     lowPass1  = WDFilter::create(WDFilter::Type::LowPass, WDFilter::Order::First);
     lowPass2  = WDFilter::create(WDFilter::Type::LowPass, WDFilter::Order::Second);
@@ -120,6 +132,11 @@ void AudioPluginAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
     highPass2 = WDFilter::create(WDFilter::Type::HighPass, WDFilter::Order::Second);
     bandPass1 = WDFilter::create(WDFilter::Type::BandPass, WDFilter::Order::First);
     bandPass2 = WDFilter::create(WDFilter::Type::BandPass, WDFilter::Order::Second);
+    resonator = std::make_unique<WDFRLCBandPass>();
+
+    svfLowPass  = std::make_unique<StateVariableFilter>(WDFilter::Type::LowPass);
+    svfHighPass = std::make_unique<StateVariableFilter>(WDFilter::Type::HighPass);
+    svfBandPass = std::make_unique<StateVariableFilter>(WDFilter::Type::BandPass);
 
     // Prepare all filters
     lowPass1->prepare(sampleRate);
@@ -128,6 +145,10 @@ void AudioPluginAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
     highPass2->prepare(sampleRate);
     bandPass1->prepare(sampleRate);
     bandPass2->prepare(sampleRate);
+    resonator->prepare(sampleRate);
+    svfLowPass->prepare(sampleRate);
+    svfHighPass->prepare(sampleRate);
+    svfBandPass->prepare(sampleRate);
 
     // Set initial filter (default to lowPass1)
     currentFilter = lowPass1.get();
@@ -165,16 +186,24 @@ bool AudioPluginAudioProcessor::isBusesLayoutSupported(const BusesLayout& layout
 
 void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    BlockTimer::Scope timing(blockTimer, buffer.getNumSamples());
     juce::ignoreUnused(midiMessages);
     juce::ScopedNoDenormals noDenormals;
     auto                    totalNumInputChannels  = getTotalNumInputChannels();
     auto                    totalNumOutputChannels = getTotalNumOutputChannels();
 
     float cutoff      = apvts.getRawParameterValue("cutoff")->load();
+    float bandwidth   = apvts.getRawParameterValue("bandwidth")->load();
     int   filterType  = static_cast<int>(apvts.getRawParameterValue("filterType")->load());
+    bool  rlcBandPass = apvts.getRawParameterValue("resonator")->load() >= 0.5f;
+    int   engine      = static_cast<int>(apvts.getRawParameterValue("engine")->load());
     int   filterOrder = static_cast<int>(apvts.getRawParameterValue("filterOrder")
                                            ->load()); // Select the current filter based on filterType and filterOrder
-    if (filterType == 0 && filterOrder == 0)
+    if (engine == 1) // the state-variable filter is second order; the resonator switch has no effect on it
+        currentFilter = filterType == 0 ? svfLowPass.get() : (filterType == 1 ? svfHighPass.get() : svfBandPass.get());
+    else if (filterType == 2 && rlcBandPass)
+        currentFilter = resonator.get();
+    else if (filterType == 0 && filterOrder == 0)
         currentFilter = lowPass1.get();
     else if (filterType == 0 && filterOrder == 1)
         currentFilter = lowPass2.get();
@@ -189,21 +218,21 @@ void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
     else
         currentFilter = nullptr;
 
+    // Both only recompute the circuit when the value changed since the last block
     if (currentFilter != nullptr)
+    {
+        currentFilter->setBandwidth(bandwidth);
         currentFilter->setCutoff(cutoff);
+    }
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
+    if (currentFilter == nullptr)
+        return;
+
     for (int channel = 0; channel < totalNumInputChannels; ++channel)
-    {
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            double x = buffer.getSample(channel, i);
-            double y = currentFilter != nullptr ? currentFilter->processSample(x) : x;
-            buffer.setSample(channel, i, static_cast<float>(y));
-        }
-    }
+        currentFilter->processBlock(buffer.getWritePointer(channel), buffer.getNumSamples());
 }
 
 //==============================================================================
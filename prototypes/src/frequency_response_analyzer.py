@@ -1,4 +1,6 @@
+import argparse
 import csv
+import sys
 from pathlib import Path
 from typing import List, Tuple, Union
 
@@ -104,7 +106,19 @@ def write_csv(
             writer.writerow([f"{freq:.6f}", f"{mag:.6f}", f"{phase:.6f}"])
 
 
-def generate_filename(filter_type: str, order: int, cutoff_freq: float) -> str:
+def make_cpp_filter(filter_type: str, order: int, sample_rate: float, cutoff_freq: float):
+    """
+    Create the C++ WDFilter of the given type through the wdfcore bindings.
+
+    The bindings live in ``wdf_capi/python`` and need the ``wdf_capi`` library to be built.
+    """
+    sys.path.insert(0, str(Path(__file__).resolve().parents[2] / "wdf_capi" / "python"))
+    import wdfcore
+
+    return wdfcore.Filter(filter_type.lower(), order, sample_rate, cutoff_freq)
+
+
+def generate_filename(filter_type: str, order: int, cutoff_freq: float, prefix: str = "pywdf") -> str:
     """
     Generate a filename for the frequency response CSV.
 
@@ -116,16 +130,27 @@ def generate_filename(filter_type: str, order: int, cutoff_freq: float) -> str:
         Filter order (1 or 2)
     cutoff_freq : float
         Cutoff frequency in Hz
+    prefix : str, optional
+        Implementation the data came from, by default "pywdf"
 
     Returns
     -------
     str
         Generated filename
     """
-    return f"pywdf_{filter_type}_order{order}_{int(cutoff_freq)}Hz.csv"
+    return f"{prefix}_{filter_type}_order{order}_{int(cutoff_freq)}Hz.csv"
 
 
 def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--engine",
+        choices=["pywdf", "cpp"],
+        default="pywdf",
+        help="pywdf prototypes, or the C++ filters through the wdfcore bindings (files prefixed wdfcore_)",
+    )
+    args = parser.parse_args()
+
     # Define constants
     SAMPLE_RATE = 48000.0
     CUTOFF_FREQ = 1000.0
@@ -138,43 +163,25 @@ def main():
     print("Generating frequency response CSVs for all filter types...")
     print(f"Output directory: {output_dir.absolute()}")
 
-    # Generate responses for low pass filters
-    for order in [1, 2]:
-        if order == 1:
-            filter_instance = RCLowPass(SAMPLE_RATE, CUTOFF_FREQ)
-        else:
-            filter_instance = RC2ndOrderLowPass(SAMPLE_RATE, CUTOFF_FREQ)
-        frequencies, magnitudes, phases = calculate_frequency_response(
-            filter_instance, SAMPLE_RATE, FFT_ORDER
-        )
-        filename = generate_filename("LowPass", order, CUTOFF_FREQ)
-        write_csv(output_dir / filename, frequencies, magnitudes, phases)
-        print(f"Generated {filename}")
-
-    # Generate responses for high pass filters
-    for order in [1, 2]:
-        if order == 1:
-            filter_instance = RCHighPass(SAMPLE_RATE, CUTOFF_FREQ)
+    prototypes = {
+        ("LowPass", 1): RCLowPass,
+        ("LowPass", 2): RC2ndOrderLowPass,
+        ("HighPass", 1): RCHighPass,
+        ("HighPass", 2): RC2ndOrderHighPass,
+        ("BandPass", 1): RCBandPass1st,
+        ("BandPass", 2): RCBandPass2nd,
+    }
+    prefix = "wdfcore" if args.engine == "cpp" else "pywdf"
+
+    for (filter_type, order), prototype in prototypes.items():
+        if args.engine == "cpp":
+            filter_instance = make_cpp_filter(filter_type, order, SAMPLE_RATE, CUTOFF_FREQ)
         else:
-            filter_instance = RC2ndOrderHighPass(SAMPLE_RATE, CUTOFF_FREQ)
-        frequencies, magnitudes, phases = calculate_frequency_response(
-            filter_instance, SAMPLE_RATE, FFT_ORDER
-        )
-        filename = generate_filename("HighPass", order, CUTOFF_FREQ)
-        write_csv(output_dir / filename, frequencies, magnitudes, phases)
-        print(f"Generated {filename}")
-
-    # Generate responses for band pass filters
-    for order in [1, 2]:
-        if order == 1:
-            filter_instance = RCBandPass1st(SAMPLE_RATE, CUTOFF_FREQ)
-        else:
-            filter_instance = RCBandPass2nd(SAMPLE_RATE, CUTOFF_FREQ)
-
+            filter_instance = prototype(SAMPLE_RATE, CUTOFF_FREQ)
         frequencies, magnitudes, phases = calculate_frequency_response(
             filter_instance, SAMPLE_RATE, FFT_ORDER
         )
-        filename = generate_filename("BandPass", order, CUTOFF_FREQ)
+        filename = generate_filename(filter_type, order, CUTOFF_FREQ, prefix)
         write_csv(output_dir / filename, frequencies, magnitudes, phases)
         print(f"Generated {filename}")
 
@@ -1,3 +1,4 @@
+import argparse
 import csv
 from pathlib import Path
 from typing import Dict, List, Tuple, Union
@@ -5,6 +6,7 @@ from typing import Dict, List, Tuple, Union
 import numpy as np
 import time
 
+from .frequency_response_analyzer import make_cpp_filter
 from .rc_1st2ndorder_bandpass import RCBandPass1st, RCBandPass2nd
 from .rc_highpass import RCHighPass
 from .rc_lowpass import RCLowPass
@@ -69,7 +71,7 @@ def write_csv(filename: Path, results: Dict[str, float]) -> None:
             writer.writerow([name, f"{rtf:.6f}"])
 
 
-def generate_filename(cutoff_freq: float) -> str:
+def generate_filename(cutoff_freq: float, prefix: str = "pywdf") -> str:
     """
     Generate a filename for the real-time factor CSV.
 
@@ -77,16 +79,28 @@ def generate_filename(cutoff_freq: float) -> str:
     ----------
     cutoff_freq : float
         Cutoff frequency in Hz
+    prefix : str, optional
+        Implementation that was measured, by default "pywdf"
 
     Returns
     -------
     str
         Generated filename
     """
-    return f"pywdf_rtf_analysis_{int(cutoff_freq)}Hz.csv"
+    return f"{prefix}_rtf_analysis_{int(cutoff_freq)}Hz.csv"
 
 
 def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--engine",
+        choices=["pywdf", "cpp"],
+        default="pywdf",
+        help="pywdf prototypes, or the C++ filters through the wdfcore bindings (file prefixed wdfcore_)",
+    )
+    args = parser.parse_args()
+    use_cpp = args.engine == "cpp"
+
     # Define constants
     SAMPLE_RATE = 48000.0
     CUTOFF_FREQ = 1000.0
@@ -107,7 +121,10 @@ def main():
 
     # Test low pass filters
     for order in [1, 2]:
-        filter_instance = RCLowPass(SAMPLE_RATE, CUTOFF_FREQ)
+        if use_cpp:
+            filter_instance = make_cpp_filter("LowPass", order, SAMPLE_RATE, CUTOFF_FREQ)
+        else:
+            filter_instance = RCLowPass(SAMPLE_RATE, CUTOFF_FREQ)
         rtf = calculate_real_time_factor(filter_instance, SAMPLE_RATE, TEST_SECONDS)
         name = f"LowPass (order {order})"
         results[name] = rtf
@@ -115,7 +132,10 @@ def main():
 
     # Test high pass filters
     for order in [1, 2]:
-        filter_instance = RCHighPass(SAMPLE_RATE, CUTOFF_FREQ)
+        if use_cpp:
+            filter_instance = make_cpp_filter("HighPass", order, SAMPLE_RATE, CUTOFF_FREQ)
+        else:
+            filter_instance = RCHighPass(SAMPLE_RATE, CUTOFF_FREQ)
         rtf = calculate_real_time_factor(filter_instance, SAMPLE_RATE, TEST_SECONDS)
         name = f"HighPass (order {order})"
         results[name] = rtf
@@ -123,7 +143,9 @@ def main():
 
     # Test band pass filters
     for order in [1, 2]:
-        if order == 1:
+        if use_cpp:
+            filter_instance = make_cpp_filter("BandPass", order, SAMPLE_RATE, CUTOFF_FREQ)
+        elif order == 1:
             filter_instance = RCBandPass1st(SAMPLE_RATE, CUTOFF_FREQ)
         else:
             filter_instance = RCBandPass2nd(SAMPLE_RATE, CUTOFF_FREQ)
@@ -134,7 +156,7 @@ def main():
         print(f"{name}: RTF = {rtf:.6f}")
 
     # Save results to CSV
-    filename = generate_filename(CUTOFF_FREQ)
+    filename = generate_filename(CUTOFF_FREQ, "wdfcore" if use_cpp else "pywdf")
     write_csv(output_dir / filename, results)
     print(f"\nResults saved to {filename}")
     print("\nReal-time factor analysis complete!")
@@ -0,0 +1,211 @@
+#pragma once
+
+/*
+ * C interface to the wdf_core filters and diode clipper.
+ *
+ * Every handle owns one processing engine per channel. Handles are not thread-safe: prepare,
+ * parameter changes and processing on one handle must not run concurrently, but different handles
+ * are independent. Processing functions never allocate, lock or throw.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(WDF_CAPI_BUILD)
+#define WDF_CAPI_EXPORT __declspec(dllexport)
+#else
+#define WDF_CAPI_EXPORT __declspec(dllimport)
+#endif
+#else
+#define WDF_CAPI_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Incremented on every incompatible change to this header */
+#define WDF_CAPI_VERSION 1
+
+    typedef enum wdf_status
+    {
+        WDF_OK                     = 0,
+        WDF_ERROR_INVALID_ARGUMENT = -1,
+        WDF_ERROR_NOT_PREPARED     = -2,
+        WDF_ERROR_OUT_OF_MEMORY    = -3
+    } wdf_status;
+
+    typedef enum wdf_filter_type
+    {
+        WDF_FILTER_LOWPASS  = 0,
+        WDF_FILTER_HIGHPASS = 1,
+        WDF_FILTER_BANDPASS = 2
+    } wdf_filter_type;
+
+    typedef enum wdf_filter_order
+    {
+        WDF_FILTER_ORDER_FIRST  = 1,
+        WDF_FILTER_ORDER_SECOND = 2
+    } wdf_filter_order;
+
+    typedef struct wdf_filter  wdf_filter;
+    typedef struct wdf_clipper wdf_clipper;
+
+    /**
+     * @brief Version of the interface the library was built with
+     * @return WDF_CAPI_VERSION of the library; compare against the header's value
+     */
+    WDF_CAPI_EXPORT uint32_t wdf_get_api_version(void);
+
+    /**
+     * @brief Human-readable description of a status code
+     * @param status Status returned by any wdf_* function
+     * @return Static string; never NULL
+     */
+    WDF_CAPI_EXPORT const char* wdf_status_string(wdf_status status);
+
+    /* ---- WDFilter ------------------------------------------------------------------------------ */
+
+    /**
+     * @brief Creates a filter with one engine per channel
+     * @param type Low-, high- or band-pass
+     * @param order First or second order
+     * @param num_channels Number of channels processed by this handle (at least 1)
+     * @return New handle, or NULL if an argument is invalid or memory is exhausted
+     */
+    WDF_CAPI_EXPORT wdf_filter* wdf_filter_create(wdf_filter_type type, wdf_filter_order order, int num_channels);
+
+    /**
+     * @brief Destroys a filter; NULL is ignored
+     */
+    WDF_CAPI_EXPORT void wdf_filter_destroy(wdf_filter* filter);
+
+    /**
+     * @brief Prepares every channel for the given sample rate; must be called before processing
+     * @param filter Filter handle
+     * @param sample_rate Sample rate in Hz
+     * @return WDF_OK, or WDF_ERROR_INVALID_ARGUMENT
+     */
+    WDF_CAPI_EXPORT wdf_status wdf_filter_prepare(wdf_filter* filter, double sample_rate);
+
+    /**
+     * @brief Sets the cutoff (centre frequency for band-pass filters) of every channel
+     * @param filter Filter handle
+     * @param cutoff_hz Cutoff in Hz, clamped to [20 Hz, 0.45 fs]
+     * @return WDF_OK, WDF_ERROR_INVALID_ARGUMENT or WDF_ERROR_NOT_PREPARED
+     */
+    WDF_CAPI_EXPORT wdf_status wdf_filter_set_cutoff(wdf_filter* filter, double cutoff_hz);
+
+    /**
+     * @brief Current cutoff after clamping
+     * @return Cutoff in Hz, or 0 for a NULL handle
+     */
+    WDF_CAPI_EXPORT double wdf_filter_get_cutoff(const wdf_filter* filter);
+
+    WDF_CAPI_EXPORT int wdf_filter_get_num_channels(const wdf_filter* filter);
+
+    /**
+     * @brief Processes non-interleaved audio in place
+     * @param filter Filter handle
+     * @param channels One pointer per channel of the handle; a NULL pointer skips that channel
+     * @param num_frames Samples per channel
+     * @return WDF_OK, WDF_ERROR_INVALID_ARGUMENT or WDF_ERROR_NOT_PREPARED
+     */
+    WDF_CAPI_EXPORT wdf_status wdf_filter_process(wdf_filter* filter, float* const* channels, size_t num_frames);
+
+    /**
+     * @brief Processes interleaved audio in place
+     * @param filter Filter handle
+     * @param interleaved num_frames frames of get_num_channels() samples each
+     * @param num_frames Number of frames
+     * @return WDF_OK, WDF_ERROR_INVALID_ARGUMENT or WDF_ERROR_NOT_PREPARED
+     */
+    WDF_CAPI_EXPORT wdf_status wdf_filter_process_interleaved(wdf_filter* filter,
+                                                              float*      interleaved,
+                                                              size_t      num_frames);
+
+    /**
+     * @brief Renders one mono signal through a fresh filter per cutoff
+     *
+     * Batch entry point for parameter sweeps: row k of output is input filtered at cutoffs_hz[k],
+     * starting from a freshly prepared filter. Allocates internally; not for real-time use.
+     * @param type Low-, high- or band-pass
+     * @param order First or second order
+     * @param sample_rate Sample rate in Hz
+     * @param cutoffs_hz num_cutoffs cutoff frequencies in Hz
+     * @param num_cutoffs Number of rows to render
+     * @param input num_frames input samples
+     * @param output num_cutoffs * num_frames samples, row-major; must not overlap input
+     * @param num_frames Samples per row
+     * @return WDF_OK, WDF_ERROR_INVALID_ARGUMENT or WDF_ERROR_OUT_OF_MEMORY
+     */
+    WDF_CAPI_EXPORT wdf_status wdf_filter_sweep(wdf_filter_type  type,
+                                                wdf_filter_order order,
+                                                double           sample_rate,
+                                                const double*    cutoffs_hz,
+                                                size_t           num_cutoffs,
+                                                const float*     input,
+                                                float*           output,
+                                                size_t           num_frames);
+
+    /* ---- Diode clipper ------------------------------------------------------------------------- */
+
+    /**
+     * @brief Creates a diode clipper with one engine per channel
+     * @param num_channels Number of channels processed by this handle (at least 1)
+     * @return New handle, or NULL if an argument is invalid or memory is exhausted
+     */
+    WDF_CAPI_EXPORT wdf_clipper* wdf_clipper_create(int num_channels);
+
+    /**
+     * @brief Destroys a clipper; NULL is ignored
+     */
+    WDF_CAPI_EXPORT void wdf_clipper_destroy(wdf_clipper* clipper);
+
+    /**
+     * @brief Prepares every channel for the given sample rate; must be called before processing
+     * @param clipper Clipper handle
+     * @param sample_rate Sample rate in Hz
+     * @return WDF_OK, or WDF_ERROR_INVALID_ARGUMENT
+     */
+    WDF_CAPI_EXPORT wdf_status wdf_clipper_prepare(wdf_clipper* clipper, double sample_rate);
+
+    /**
+     * @brief Sets the clipper parameters of every channel
+     * @param clipper Clipper handle
+     * @param cutoff_hz Cutoff of the RC stage in Hz, clamped to [20 Hz, 0.45 fs]
+     * @param diode_is Diode saturation current in A (2.52e-9 in the plugin)
+     * @param num_series_diodes Number of diodes in series per direction
+     * @param force_now Non-zero applies the values immediately instead of ramping over 10 ms
+     * @return WDF_OK, WDF_ERROR_INVALID_ARGUMENT or WDF_ERROR_NOT_PREPARED
+     */
+    WDF_CAPI_EXPORT wdf_status wdf_clipper_set_parameters(
+        wdf_clipper* clipper, float cutoff_hz, float diode_is, float num_series_diodes, int force_now);
+
+    WDF_CAPI_EXPORT int wdf_clipper_get_num_channels(const wdf_clipper* clipper);
+
+    /**
+     * @brief Processes non-interleaved audio in place
+     * @param clipper Clipper handle
+     * @param channels One pointer per channel of the handle; a NULL pointer skips that channel
+     * @param num_frames Samples per channel
+     * @return WDF_OK, WDF_ERROR_INVALID_ARGUMENT or WDF_ERROR_NOT_PREPARED
+     */
+    WDF_CAPI_EXPORT wdf_status wdf_clipper_process(wdf_clipper* clipper, float* const* channels, size_t num_frames);
+
+    /**
+     * @brief Processes interleaved audio in place
+     * @param clipper Clipper handle
+     * @param interleaved num_frames frames of get_num_channels() samples each
+     * @param num_frames Number of frames
+     * @return WDF_OK, WDF_ERROR_INVALID_ARGUMENT or WDF_ERROR_NOT_PREPARED
+     */
+    WDF_CAPI_EXPORT wdf_status wdf_clipper_process_interleaved(wdf_clipper* clipper,
+                                                               float*       interleaved,
+                                                               size_t       num_frames);
+
+#ifdef __cplusplus
+}
+#endif
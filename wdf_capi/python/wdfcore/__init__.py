@@ -0,0 +1,406 @@
+"""NumPy bindings to the C++ WDF filters and diode clipper.
+
+Thin ``ctypes`` wrappers around the ``wdf_capi`` shared library. Audio is handed
+to C++ as a pointer to the NumPy array's own memory, so a float32 C-contiguous
+array is processed without any copy:
+
+    >>> import numpy as np, wdfcore
+    >>> lp = wdfcore.Filter("lowpass", order=2, sample_rate=48000, cutoff_hz=1000)
+    >>> x = np.random.default_rng(0).standard_normal(48000).astype(np.float32)
+    >>> y = lp.process(x)            # new array, input untouched
+    >>> lp.process_inplace(x)        # zero-copy, overwrites x
+
+The library is located through the ``WDF_CAPI_LIBRARY`` environment variable,
+then in the repository's ``build*/wdf_capi`` directories, then on the system
+library path.
+"""
+
+import ctypes
+import ctypes.util
+import os
+import sys
+from pathlib import Path
+from typing import Optional, Sequence, Union
+
+import numpy as np
+
+__all__ = ["Filter", "DiodeClipper", "WDFError", "sweep", "load_library"]
+
+_API_VERSION = 1
+
+_FILTER_TYPES = {"lowpass": 0, "highpass": 1, "bandpass": 2}
+_FILTER_ORDERS = {1: 1, 2: 2}
+
+_c_float_p = ctypes.POINTER(ctypes.c_float)
+_c_double_p = ctypes.POINTER(ctypes.c_double)
+
+_lib = None
+
+
+class WDFError(RuntimeError):
+    """Raised when a wdf_capi call returns an error status."""
+
+
+def _library_names():
+    if sys.platform == "win32":
+        return ["wdf_capi.dll"]
+    if sys.platform == "darwin":
+        return ["libwdf_capi.dylib"]
+    return ["libwdf_capi.so"]
+
+
+def _candidate_paths():
+    env = os.environ.get("WDF_CAPI_LIBRARY")
+    if env:
+        yield Path(env)
+
+    repo_root = Path(__file__).resolve().parents[3]
+    for build_dir in sorted(repo_root.glob("build*")):
+        for name in _library_names():
+            # Single-config generators put the library in wdf_capi/, multi-config ones in wdf_capi/<Config>/
+            yield build_dir / "wdf_capi" / name
+            for config in ("Release", "RelWithDebInfo", "Debug"):
+                yield build_dir / "wdf_capi" / config / name
+
+    found = ctypes.util.find_library("wdf_capi")
+    if found:
+        yield Path(found)
+
+
+def _declare(lib):
+    handle = ctypes.c_void_p
+    status = ctypes.c_int
+    size = ctypes.c_size_t
+    signatures = {
+        "wdf_get_api_version": (ctypes.c_uint32, []),
+        "wdf_status_string": (ctypes.c_char_p, [status]),
+        "wdf_filter_create": (handle, [ctypes.c_int, ctypes.c_int, ctypes.c_int]),
+        "wdf_filter_destroy": (None, [handle]),
+        "wdf_filter_prepare": (status, [handle, ctypes.c_double]),
+        "wdf_filter_set_cutoff": (status, [handle, ctypes.c_double]),
+        "wdf_filter_get_cutoff": (ctypes.c_double, [handle]),
+        "wdf_filter_process": (status, [handle, ctypes.POINTER(_c_float_p), size]),
+        "wdf_filter_process_interleaved": (status, [handle, _c_float_p, size]),
+        "wdf_filter_sweep": (
+            status,
+            [ctypes.c_int, ctypes.c_int, ctypes.c_double, _c_double_p, size, _c_float_p, _c_float_p, size],
+        ),
+        "wdf_clipper_create": (handle, [ctypes.c_int]),
+        "wdf_clipper_destroy": (None, [handle]),
+        "wdf_clipper_prepare": (status, [handle, ctypes.c_double]),
+        "wdf_clipper_set_parameters": (
+            status,
+            [handle, ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_int],
+        ),
+        "wdf_clipper_process": (status, [handle, ctypes.POINTER(_c_float_p), size]),
+        "wdf_clipper_process_interleaved": (status, [handle, _c_float_p, size]),
+    }
+    for name, (restype, argtypes) in signatures.items():
+        function = getattr(lib, name)
+        function.restype = restype
+        function.argtypes = argtypes
+
+
+def load_library(path: Optional[Union[str, Path]] = None) -> ctypes.CDLL:
+    """Load (once) and return the wdf_capi shared library.
+
+    Parameters
+    ----------
+    path : str or Path, optional
+        Explicit library path; overrides the search described in the module docstring.
+    """
+    global _lib
+    if _lib is not None and path is None:
+        return _lib
+
+    candidates = [Path(path)] if path is not None else _candidate_paths()
+    for candidate in candidates:
+        if candidate.exists() or candidate.name == str(candidate):
+            try:
+                lib = ctypes.CDLL(str(candidate))
+            except OSError:
+                continue
+            _declare(lib)
+            version = lib.wdf_get_api_version()
+            if version != _API_VERSION:
+                raise WDFError(f"{candidate}: wdf_capi version {version}, expected {_API_VERSION}")
+            _lib = lib
+            return lib
+
+    raise WDFError(
+        "wdf_capi library not found; build the wdf_capi target or set WDF_CAPI_LIBRARY to its path"
+    )
+
+
+def _check(status: int) -> None:
+    if status != 0:
+        raise WDFError(load_library().wdf_status_string(status).decode())
+
+
+def _as_float_pointer(array: np.ndarray):
+    return array.ctypes.data_as(_c_float_p)
+
+
+def _require_processable(block: np.ndarray) -> None:
+    if not isinstance(block, np.ndarray) or block.dtype != np.float32:
+        raise TypeError("expected a float32 numpy.ndarray")
+    if not block.flags.c_contiguous or not block.flags.writeable:
+        raise TypeError("expected a writable C-contiguous array")
+
+
+class _Processor:
+    """Shared block-processing logic for the filter and clipper handles."""
+
+    _prefix = ""  # "wdf_filter" or "wdf_clipper"
+
+    def __init__(self, handle, channels: int) -> None:
+        if not handle:
+            raise WDFError("could not create the processor (invalid arguments or out of memory)")
+        lib = load_library()
+        self._handle = handle
+        self._destroy = getattr(lib, self._prefix + "_destroy")
+        self._process = getattr(lib, self._prefix + "_process")
+        self._process_interleaved = getattr(lib, self._prefix + "_process_interleaved")
+        self.channels = channels
+
+    def __del__(self) -> None:
+        handle = getattr(self, "_handle", None)
+        if handle:
+            self._destroy(handle)
+            self._handle = None
+
+    def process_inplace(self, block: np.ndarray, interleaved: bool = False) -> np.ndarray:
+        """Process a float32 C-contiguous block in place, without copying.
+
+        Parameters
+        ----------
+        block : np.ndarray
+            Shape ``(frames,)`` for one channel, ``(channels, frames)`` for planar
+            audio, or ``(frames, channels)`` with ``interleaved=True``.
+        interleaved : bool
+            Whether a 2-D block is frame-major.
+
+        Returns
+        -------
+        np.ndarray
+            ``block`` itself.
+        """
+        _require_processable(block)
+
+        if block.ndim == 1:
+            if self.channels != 1 and not interleaved:
+                raise ValueError(f"1-D blocks need a single-channel processor, this one has {self.channels}")
+            if interleaved:
+                if block.size % self.channels:
+                    raise ValueError("interleaved block length is not a multiple of the channel count")
+                frames = block.size // self.channels
+                _check(self._process_interleaved(self._handle, _as_float_pointer(block), frames))
+            else:
+                pointers = (_c_float_p * 1)(_as_float_pointer(block))
+                _check(self._process(self._handle, pointers, block.shape[0]))
+            return block
+
+        if block.ndim != 2:
+            raise ValueError("expected a 1-D or 2-D block")
+
+        if interleaved:
+            frames, channels = block.shape
+            if channels != self.channels:
+                raise ValueError(f"block has {channels} channels, processor has {self.channels}")
+            _check(self._process_interleaved(self._handle, _as_float_pointer(block), frames))
+        else:
+            channels, frames = block.shape
+            if channels != self.channels:
+                raise ValueError(f"block has {channels} channels, processor has {self.channels}")
+            row_bytes = block.strides[0]
+            base = block.ctypes.data
+            pointers = (_c_float_p * channels)(
+                *(ctypes.cast(base + ch * row_bytes, _c_float_p) for ch in range(channels))
+            )
+            _check(self._process(self._handle, pointers, frames))
+        return block
+
+    def process(self, block, out: Optional[np.ndarray] = None, interleaved: bool = False) -> np.ndarray:
+        """Process a block and return the result, leaving the input untouched.
+
+        The input is copied once into ``out`` (a new float32 array if not given)
+        and processed there; pass a preallocated ``out`` to avoid the allocation.
+        """
+        if out is None:
+            out = np.array(block, dtype=np.float32, order="C", copy=True)
+        else:
+            np.copyto(out, block, casting="same_kind")
+        return self.process_inplace(out, interleaved=interleaved)
+
+    def process_block(self, block) -> np.ndarray:
+        """Same as :meth:`process`; matches ``process_block()`` of the pywdf prototypes."""
+        return self.process(block)
+
+
+class Filter(_Processor):
+    """A WDFilter (RC low-, high- or band-pass) with one engine per channel.
+
+    Parameters
+    ----------
+    filter_type : str
+        ``"lowpass"``, ``"highpass"`` or ``"bandpass"``.
+    order : int
+        1 or 2.
+    sample_rate : float
+        Sample rate in Hz.
+    cutoff_hz : float
+        Cutoff (centre frequency for band-pass) in Hz, clamped to [20 Hz, 0.45 fs].
+    channels : int
+        Number of channels processed by this instance.
+    """
+
+    _prefix = "wdf_filter"
+
+    def __init__(
+        self,
+        filter_type: str = "lowpass",
+        order: int = 1,
+        sample_rate: float = 48000.0,
+        cutoff_hz: float = 1000.0,
+        channels: int = 1,
+    ) -> None:
+        lib = load_library()
+        self.filter_type = filter_type
+        self.order = order
+        super().__init__(
+            lib.wdf_filter_create(_filter_type_id(filter_type), _filter_order_id(order), channels), channels
+        )
+        self.prepare(sample_rate)
+        self.cutoff = cutoff_hz
+
+    def prepare(self, sample_rate: float) -> None:
+        """Reset every channel for a new sample rate; the cutoff must be set again."""
+        _check(load_library().wdf_filter_prepare(self._handle, float(sample_rate)))
+        self.sample_rate = float(sample_rate)
+
+    @property
+    def cutoff(self) -> float:
+        """Current cutoff in Hz, after clamping."""
+        return load_library().wdf_filter_get_cutoff(self._handle)
+
+    @cutoff.setter
+    def cutoff(self, cutoff_hz: float) -> None:
+        _check(load_library().wdf_filter_set_cutoff(self._handle, float(cutoff_hz)))
+
+
+class DiodeClipper(_Processor):
+    """The diode clipper (RC stage into an antiparallel diode pair), one engine per channel.
+
+    Parameters
+    ----------
+    sample_rate : float
+        Sample rate in Hz.
+    cutoff_hz : float
+        Cutoff of the RC stage in Hz.
+    diode_is : float
+        Diode saturation current in A.
+    num_series_diodes : float
+        Diodes in series per direction.
+    channels : int
+        Number of channels processed by this instance.
+    """
+
+    _prefix = "wdf_clipper"
+
+    def __init__(
+        self,
+        sample_rate: float = 48000.0,
+        cutoff_hz: float = 1000.0,
+        diode_is: float = 2.52e-9,
+        num_series_diodes: float = 2.0,
+        channels: int = 1,
+    ) -> None:
+        lib = load_library()
+        super().__init__(lib.wdf_clipper_create(channels), channels)
+        self.prepare(sample_rate)
+        self.set_parameters(cutoff_hz, diode_is, num_series_diodes, force_now=True)
+
+    def prepare(self, sample_rate: float) -> None:
+        """Reset every channel for a new sample rate; parameters must be set again."""
+        _check(load_library().wdf_clipper_prepare(self._handle, float(sample_rate)))
+        self.sample_rate = float(sample_rate)
+
+    def set_parameters(
+        self, cutoff_hz: float, diode_is: float, num_series_diodes: float, force_now: bool = False
+    ) -> None:
+        """Set the clipper parameters; without ``force_now`` they ramp over 10 ms."""
+        _check(
+            load_library().wdf_clipper_set_parameters(
+                self._handle, cutoff_hz, diode_is, num_series_diodes, int(force_now)
+            )
+        )
+
+
+def _filter_type_id(filter_type: str) -> int:
+    try:
+        return _FILTER_TYPES[filter_type.lower()]
+    except KeyError:
+        raise ValueError(f"unknown filter type {filter_type!r}; expected one of {list(_FILTER_TYPES)}") from None
+
+
+def _filter_order_id(order: int) -> int:
+    try:
+        return _FILTER_ORDERS[int(order)]
+    except KeyError:
+        raise ValueError(f"unsupported filter order {order}; expected 1 or 2") from None
+
+
+def sweep(
+    filter_type: str,
+    order: int,
+    sample_rate: float,
+    cutoffs_hz: Sequence[float],
+    signal: np.ndarray,
+    out: Optional[np.ndarray] = None,
+) -> np.ndarray:
+    """Render one mono signal through a fresh filter per cutoff in a single C++ call.
+
+    Parameters
+    ----------
+    filter_type, order, sample_rate
+        As for :class:`Filter`.
+    cutoffs_hz : sequence of float
+        One cutoff per output row.
+    signal : np.ndarray
+        1-D input; used without copying when it is float32 and contiguous.
+    out : np.ndarray, optional
+        Preallocated float32 C-contiguous array of shape ``(len(cutoffs_hz), len(signal))``.
+
+    Returns
+    -------
+    np.ndarray
+        Array of shape ``(len(cutoffs_hz), len(signal))``; e.g. pass a unit impulse
+        to get the impulse response at every cutoff.
+    """
+    lib = load_library()
+    signal = np.ascontiguousarray(signal, dtype=np.float32)
+    if signal.ndim != 1:
+        raise ValueError("sweep() expects a 1-D signal")
+    cutoffs = np.ascontiguousarray(cutoffs_hz, dtype=np.float64).reshape(-1)
+
+    shape = (cutoffs.size, signal.size)
+    if out is None:
+        out = np.empty(shape, dtype=np.float32)
+    else:
+        _require_processable(out)
+        if out.shape != shape:
+            raise ValueError(f"out has shape {out.shape}, expected {shape}")
+
+    _check(
+        lib.wdf_filter_sweep(
+            _filter_type_id(filter_type),
+            _filter_order_id(order),
+            float(sample_rate),
+            cutoffs.ctypes.data_as(_c_double_p),
+            cutoffs.size,
+            _as_float_pointer(signal),
+            _as_float_pointer(out),
+            signal.size,
+        )
+    )
+    return out
@@ -0,0 +1,335 @@
+#include "wdf_capi/wdf_capi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "DiodeClipper/WDFDiodeClipper.h"
+#include "WDFilters/WDFilter.h"
+#include "wdf_core/ScopedNoDenormals.h"
+
+// The opaque handles hold one engine per channel. Everything that allocates happens in the
+// create functions; exceptions never cross the C boundary. Processing runs with denormals flushed,
+// as in the plugins, and restores the caller's floating-point mode on return.
+struct wdf_filter
+{
+    std::vector<std::unique_ptr<WDFilter>> channels;
+    bool                                   prepared = false;
+};
+
+struct wdf_clipper
+{
+    std::vector<std::unique_ptr<WDFDiodeClipperJUCE>> channels;
+    bool                                              prepared = false;
+};
+
+static bool isValidSampleRate(double sampleRate)
+{
+    return std::isfinite(sampleRate) && sampleRate > 0.0;
+}
+
+template <typename Handle>
+static wdf_status checkProcessArguments(const Handle* handle, const void* buffer, size_t numFrames)
+{
+    if (handle == nullptr || (buffer == nullptr && numFrames > 0))
+        return WDF_ERROR_INVALID_ARGUMENT;
+    if (!handle->prepared)
+        return WDF_ERROR_NOT_PREPARED;
+    return WDF_OK;
+}
+
+// processBlock() counts samples in an int, so longer buffers go through in chunks
+template <typename Engine>
+static void processBlockInChunks(Engine& engine, float* samples, size_t numFrames)
+{
+    constexpr size_t maxChunk = static_cast<size_t>(std::numeric_limits<int>::max());
+    for (size_t start = 0; start < numFrames; start += maxChunk)
+        engine.processBlock(samples + start, static_cast<int>(std::min(maxChunk, numFrames - start)));
+}
+
+static bool toFilterType(wdf_filter_type type, WDFilter::Type& result)
+{
+    switch (type)
+    {
+    case WDF_FILTER_LOWPASS:
+        result = WDFilter::Type::LowPass;
+        return true;
+    case WDF_FILTER_HIGHPASS:
+        result = WDFilter::Type::HighPass;
+        return true;
+    case WDF_FILTER_BANDPASS:
+        result = WDFilter::Type::BandPass;
+        return true;
+    }
+    return false;
+}
+
+static bool toFilterOrder(wdf_filter_order order, WDFilter::Order& result)
+{
+    switch (order)
+    {
+    case WDF_FILTER_ORDER_FIRST:
+        result = WDFilter::Order::First;
+        return true;
+    case WDF_FILTER_ORDER_SECOND:
+        result = WDFilter::Order::Second;
+        return true;
+    }
+    return false;
+}
+
+uint32_t wdf_get_api_version(void)
+{
+    return WDF_CAPI_VERSION;
+}
+
+const char* wdf_status_string(wdf_status status)
+{
+    switch (status)
+    {
+    case WDF_OK:
+        return "ok";
+    case WDF_ERROR_INVALID_ARGUMENT:
+        return "invalid argument";
+    case WDF_ERROR_NOT_PREPARED:
+        return "prepare() has not been called";
+    case WDF_ERROR_OUT_OF_MEMORY:
+        return "out of memory";
+    }
+    return "unknown status";
+}
+
+/*======================================================================*/
+wdf_filter* wdf_filter_create(wdf_filter_type type, wdf_filter_order order, int num_channels)
+{
+    WDFilter::Type  filterType;
+    WDFilter::Order filterOrder;
+    if (!toFilterType(type, filterType) || !toFilterOrder(order, filterOrder))
+        return nullptr;
+
+    if (num_channels < 1)
+        return nullptr;
+
+    try
+    {
+        auto filter = std::make_unique<wdf_filter>();
+        filter->channels.reserve(static_cast<size_t>(num_channels));
+        for (int ch = 0; ch < num_channels; ++ch)
+            filter->channels.push_back(WDFilter::create(filterType, filterOrder));
+        return filter.release();
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void wdf_filter_destroy(wdf_filter* filter)
+{
+    delete filter;
+}
+
+wdf_status wdf_filter_prepare(wdf_filter* filter, double sample_rate)
+{
+    if (filter == nullptr || !isValidSampleRate(sample_rate))
+        return WDF_ERROR_INVALID_ARGUMENT;
+
+    for (auto& channel : filter->channels)
+        channel->prepare(sample_rate);
+    filter->prepared = true;
+    return WDF_OK;
+}
+
+wdf_status wdf_filter_set_cutoff(wdf_filter* filter, double cutoff_hz)
+{
+    if (filter == nullptr || !std::isfinite(cutoff_hz))
+        return WDF_ERROR_INVALID_ARGUMENT;
+    if (!filter->prepared)
+        return WDF_ERROR_NOT_PREPARED;
+
+    for (auto& channel : filter->channels)
+        channel->setCutoff(cutoff_hz);
+    return WDF_OK;
+}
+
+double wdf_filter_get_cutoff(const wdf_filter* filter)
+{
+    return filter != nullptr ? filter->channels.front()->getCutoff() : 0.0;
+}
+
+int wdf_filter_get_num_channels(const wdf_filter* filter)
+{
+    return filter != nullptr ? static_cast<int>(filter->channels.size()) : 0;
+}
+
+wdf_status wdf_filter_process(wdf_filter* filter, float* const* channels, size_t num_frames)
+{
+    if (const auto status = checkProcessArguments(filter, channels, num_frames); status != WDF_OK)
+        return status;
+
+    wdf_core::ScopedNoDenormals noDenormals;
+
+    for (size_t ch = 0; ch < filter->channels.size(); ++ch)
+    {
+        if (channels[ch] == nullptr)
+            continue;
+
+        processBlockInChunks(*filter->channels[ch], channels[ch], num_frames);
+    }
+    return WDF_OK;
+}
+
+wdf_status wdf_filter_process_interleaved(wdf_filter* filter, float* interleaved, size_t num_frames)
+{
+    if (const auto status = checkProcessArguments(filter, interleaved, num_frames); status != WDF_OK)
+        return status;
+
+    wdf_core::ScopedNoDenormals noDenormals;
+
+    // Channel-outer keeps each engine's state hot; the strided access stays within a few cache lines
+    const size_t numChannels = filter->channels.size();
+    for (size_t ch = 0; ch < numChannels; ++ch)
+    {
+        auto& engine = *filter->channels[ch];
+        for (size_t i = 0; i < num_frames; ++i)
+        {
+            float& sample = interleaved[i * numChannels + ch];
+            sample        = static_cast<float>(engine.processSample(sample));
+        }
+    }
+    return WDF_OK;
+}
+
+wdf_status wdf_filter_sweep(wdf_filter_type  type,
+                            wdf_filter_order order,
+                            double           sample_rate,
+                            const double*    cutoffs_hz,
+                            size_t           num_cutoffs,
+                            const float*     input,
+                            float*           output,
+                            size_t           num_frames)
+{
+    WDFilter::Type  filterType;
+    WDFilter::Order filterOrder;
+    if (!toFilterType(type, filterType) || !toFilterOrder(order, filterOrder) || !isValidSampleRate(sample_rate))
+        return WDF_ERROR_INVALID_ARGUMENT;
+    if (num_cutoffs > 0 && (cutoffs_hz == nullptr || (num_frames > 0 && (input == nullptr || output == nullptr))))
+        return WDF_ERROR_INVALID_ARGUMENT;
+
+    wdf_core::ScopedNoDenormals noDenormals;
+    try
+    {
+        for (size_t k = 0; k < num_cutoffs; ++k)
+        {
+            if (!std::isfinite(cutoffs_hz[k]))
+                return WDF_ERROR_INVALID_ARGUMENT;
+
+            auto filter = WDFilter::create(filterType, filterOrder);
+            filter->prepare(sample_rate);
+            filter->setCutoff(cutoffs_hz[k]);
+
+            float* row = output + k * num_frames;
+            for (size_t i = 0; i < num_frames; ++i)
+                row[i] = static_cast<float>(filter->processSample(input[i]));
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        return WDF_ERROR_OUT_OF_MEMORY;
+    }
+    return WDF_OK;
+}
+
+/*======================================================================*/
+wdf_clipper* wdf_clipper_create(int num_channels)
+{
+    if (num_channels < 1)
+        return nullptr;
+
+    try
+    {
+        auto clipper = std::make_unique<wdf_clipper>();
+        clipper->channels.reserve(static_cast<size_t>(num_channels));
+        for (int ch = 0; ch < num_channels; ++ch)
+            clipper->channels.push_back(std::make_unique<WDFDiodeClipperJUCE>());
+        return clipper.release();
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void wdf_clipper_destroy(wdf_clipper* clipper)
+{
+    delete clipper;
+}
+
+wdf_status wdf_clipper_prepare(wdf_clipper* clipper, double sample_rate)
+{
+    if (clipper == nullptr || !isValidSampleRate(sample_rate))
+        return WDF_ERROR_INVALID_ARGUMENT;
+
+    for (auto& channel : clipper->channels)
+        channel->prepare(sample_rate);
+    clipper->prepared = true;
+    return WDF_OK;
+}
+
+wdf_status wdf_clipper_set_parameters(
+    wdf_clipper* clipper, float cutoff_hz, float diode_is, float num_series_diodes, int force_now)
+{
+    if (clipper == nullptr || !std::isfinite(cutoff_hz) || !(diode_is > 0.0f) || !(num_series_diodes > 0.0f))
+        return WDF_ERROR_INVALID_ARGUMENT;
+    if (!clipper->prepared)
+        return WDF_ERROR_NOT_PREPARED;
+
+    for (auto& channel : clipper->channels)
+        channel->setParameters(cutoff_hz, diode_is, num_series_diodes, force_now != 0);
+    return WDF_OK;
+}
+
+int wdf_clipper_get_num_channels(const wdf_clipper* clipper)
+{
+    return clipper != nullptr ? static_cast<int>(clipper->channels.size()) : 0;
+}
+
+wdf_status wdf_clipper_process(wdf_clipper* clipper, float* const* channels, size_t num_frames)
+{
+    if (const auto status = checkProcessArguments(clipper, channels, num_frames); status != WDF_OK)
+        return status;
+
+    wdf_core::ScopedNoDenormals noDenormals;
+
+    for (size_t ch = 0; ch < clipper->channels.size(); ++ch)
+    {
+        if (channels[ch] == nullptr)
+            continue;
+
+        processBlockInChunks(*clipper->channels[ch], channels[ch], num_frames);
+    }
+    return WDF_OK;
+}
+
+wdf_status wdf_clipper_process_interleaved(wdf_clipper* clipper, float* interleaved, size_t num_frames)
+{
+    if (const auto status = checkProcessArguments(clipper, interleaved, num_frames); status != WDF_OK)
+        return status;
+
+    wdf_core::ScopedNoDenormals noDenormals;
+
+    const size_t numChannels = clipper->channels.size();
+    for (size_t ch = 0; ch < numChannels; ++ch)
+    {
+        auto& engine = *clipper->channels[ch];
+        for (size_t i = 0; i < num_frames; ++i)
+        {
+            float& sample = interleaved[i * numChannels + ch];
+            sample        = engine.processSample(sample);
+        }
+    }
+    return WDF_OK;
+}
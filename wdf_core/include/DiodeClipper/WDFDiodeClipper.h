@@ -1,7 +1,11 @@
 #pragma once
-#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+
 #include <chowdsp_wdf/chowdsp_wdf.h>
 
+#include "wdf_core/MathConstants.h"
+#include "wdf_core/SmoothedValue.h"
+
 namespace wdft = chowdsp::wdft;
 
 class WDFDiodeClipperJUCE
@@ -10,6 +14,12 @@ public:
     WDFDiodeClipperJUCE()  = default;
     ~WDFDiodeClipperJUCE() = default;
 
+    // The WDF adaptors hold references to sibling members: a copy or move would point into the original
+    WDFDiodeClipperJUCE(const WDFDiodeClipperJUCE&)            = delete;
+    WDFDiodeClipperJUCE& operator=(const WDFDiodeClipperJUCE&) = delete;
+    WDFDiodeClipperJUCE(WDFDiodeClipperJUCE&&)                 = delete;
+    WDFDiodeClipperJUCE& operator=(WDFDiodeClipperJUCE&&)      = delete;
+
     /*======================================================================*/
     void prepare(double newSampleRate)
     {
@@ -26,8 +36,7 @@ public:
     void setParameters(float cutoffHz, float diodeIs, float numSeriesDiodes, bool forceNow = false)
     {
         // --- clamp cutoff to the Nyquist-safe range ----------------------
-        cutoffHz = juce::jlimit(20.0f, 0.45f * (float) fs,
-                                cutoffHz); // avoids aliasing clicks
+        cutoffHz = std::clamp(cutoffHz, 20.0f, 0.45f * (float) fs); // avoids aliasing clicks
 
         if (forceNow)
         {
@@ -63,12 +72,19 @@ public:
         return y;
     }
 
+    /*======================================================================*/
+    void processBlock(float* samples, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = processSample(samples[i]);
+    }
+
 private:
     /*==================================================================*/
     static constexpr float Cval = 47.0e-9f; // 47 nF
     static constexpr float Vt   = 0.02585f; // thermal voltage
 
-    static float R_from_fc(float fc) noexcept { return 1.0f / (juce::MathConstants<float>::twoPi * fc * Cval); }
+    static float R_from_fc(float fc) noexcept { return 1.0f / (wdf_core::MathConstants<float>::twoPi * fc * Cval); }
 
     /*---- WDF tree (single series-R via ResistiveVoltageSource) --------*/
     wdft::ResistiveVoltageSourceT<float>                  Vs{R_from_fc(1000.0f)};
@@ -76,9 +92,9 @@ private:
     wdft::WDFParallelT<float, decltype(C1), decltype(Vs)> par{C1, Vs};
     wdft::DiodePairT<float, decltype(par)>                diodes{par, 2.52e-9f};
 
-    /*---- JUCE smoothing helpers --------------------------------------*/
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> cutoffSmooth;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear>         nDiodesSmooth;
+    /*---- parameter smoothing -----------------------------------------*/
+    wdf_core::SmoothedValue<float, wdf_core::ValueSmoothingTypes::Multiplicative> cutoffSmooth;
+    wdf_core::SmoothedValue<float, wdf_core::ValueSmoothingTypes::Linear>         nDiodesSmooth;
 
     float  IsCurrent{2.52e-9f};
     double fs{48000.0};
@@ -0,0 +1,374 @@
+#pragma once
+
+#include "WDFilters/HighPassFilter.h"
+#include "WDFilters/LowPassFilter.h"
+#include "WDFilters/WDFilter.h"
+
+/**
+ * @brief First-order RC Band Pass Filter using WDF
+ *
+ * Implementation of a first-order band pass filter by cascading a first-order high pass filter
+ * followed by a first-order low pass filter. The center frequency and bandwidth are controlled
+ * by setting the cutoff frequencies of the individual filters.
+ *
+ * With corners a < b the peak gain is b / (a + b), at sqrt(a b); the bilinear transform only
+ * moves that frequency, so the auto-gain 1 + a / b restores unity peak gain exactly.
+ */
+class WDFRCBandPass1st final : public WDFilter
+{
+public:
+    void prepare(double Fs) override
+    {
+        fs = Fs;
+        stage1.prepare(fs);
+        stage2.prepare(fs);
+        updateCutoffs();
+    }
+
+    double processSample(double x) override { return stage2.processSample(stage1.processSample(x)); }
+
+    void processBlock(float* samples, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
+    }
+
+    void setCutoff(double fc) override
+    {
+        const double newCutoff = std::clamp(fc, 20.0, fs * 0.45);
+        if (newCutoff == cutoff)
+            return;
+
+        cutoff = newCutoff;
+        updateCutoffs();
+    }
+
+    void setBandwidth(double octaves) override
+    {
+        const double newBandwidth = std::max(0.1, octaves); // Prevent very narrow bandwidths
+        if (newBandwidth == bandwidthInOctaves)
+            return;
+
+        bandwidthInOctaves = newBandwidth;
+        bandwidthRatio     = std::pow(2.0, bandwidthInOctaves / 2.0); // the only transcendental, per change
+        updateCutoffs();
+    }
+
+    double getBandwidth() const { return bandwidthInOctaves; }
+
+    double getCutoff() const override { return cutoff; }
+
+    Type getType() const override { return Type::BandPass; }
+
+    Order getOrder() const override { return Order::Second; }
+
+    int getStateSize() const override { return stage1.getStateSize() + stage2.getStateSize(); }
+
+    void getState(double* state) const override
+    {
+        stage1.getState(state);
+        stage2.getState(state + stage1.getStateSize());
+    }
+
+    void setState(const double* state) override
+    {
+        stage1.setState(state);
+        stage2.setState(state + stage1.getStateSize());
+    }
+
+    /**
+     * @brief Normalises the output to unity gain at the peak of the pass band; on by default
+     * @param shouldApply Whether to apply the make-up gain
+     */
+    void setAutoGain(bool shouldApply)
+    {
+        applyAutoGain = shouldApply;
+        updateAutoGain();
+    }
+
+    bool getAutoGain() const { return applyAutoGain; }
+
+private:
+    void updateCutoffs()
+    {
+        // For a bandpass, the high-pass cutoff is below the center frequency
+        // and the low-pass cutoff is above the center frequency
+        double hpCutoff = cutoff / bandwidthRatio;
+        double lpCutoff = cutoff * bandwidthRatio;
+
+        // Limit the frequencies to valid ranges
+        hpCutoff = std::clamp(hpCutoff, 20.0, fs * 0.45);
+        lpCutoff = std::clamp(lpCutoff, 20.0, fs * 0.45);
+
+        stage1.setCutoff(hpCutoff); // High-pass filter
+        stage2.setCutoff(lpCutoff); // Low-pass filter
+        updateAutoGain();
+    }
+
+    // Folded into the high-pass output, so the make-up gain adds no work per sample
+    void updateAutoGain()
+    {
+        const double ratio = stage1.getCutoff() / stage2.getCutoff();
+        stage1.setOutputGain(applyAutoGain ? 1.0 + ratio : 1.0);
+    }
+
+    WDFRCHighPass stage1;
+    WDFRCLowPass  stage2;
+
+    double fs{44100.0}, cutoff{1000.0};
+    double bandwidthInOctaves{1.0};            // Default to 1 octave
+    double bandwidthRatio{1.4142135623730951}; // 2^(bandwidthInOctaves / 2), cached by setBandwidth()
+    bool   applyAutoGain{true};
+};
+
+/**
+ * @brief Second-order RC Band Pass Filter using WDF
+ *
+ * Implementation of a second-order band pass filter by cascading a second-order high pass filter
+ * followed by a second-order low pass filter. This provides steeper filter slopes (24 dB/octave)
+ * compared to the first-order version. The center frequency and bandwidth are controlled
+ * by setting the cutoff frequencies of the individual filters.
+ *
+ * Both halves have two equal poles at their stage corners a < b, so the peak gain is the square
+ * of the first-order one, (b / (a + b))^2, and the auto-gain (1 + a / b)^2 is exact.
+ */
+class WDFRCBandPass2nd final : public WDFilter
+{
+public:
+    void prepare(double Fs) override
+    {
+        fs = Fs;
+        stage1.prepare(fs);
+        stage2.prepare(fs);
+        updateCutoffs();
+    }
+
+    double processSample(double x) override { return stage2.processSample(stage1.processSample(x)); }
+
+    void processBlock(float* samples, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
+    }
+
+    void setCutoff(double fc) override
+    {
+        const double newCutoff = std::clamp(fc, 20.0, fs * 0.45);
+        if (newCutoff == cutoff)
+            return;
+
+        cutoff = newCutoff;
+        updateCutoffs();
+    }
+
+    void setBandwidth(double octaves) override
+    {
+        const double newBandwidth = std::max(0.1, octaves); // Prevent very narrow bandwidths
+        if (newBandwidth == bandwidthInOctaves)
+            return;
+
+        bandwidthInOctaves = newBandwidth;
+        bandwidthRatio     = std::pow(2.0, bandwidthInOctaves / 2.0); // the only transcendental, per change
+        updateCutoffs();
+    }
+
+    double getBandwidth() const { return bandwidthInOctaves; }
+
+    double getCutoff() const override { return cutoff; }
+
+    Type getType() const override { return Type::BandPass; }
+
+    Order getOrder() const override { return Order::Second; }
+
+    int getStateSize() const override { return stage1.getStateSize() + stage2.getStateSize(); }
+
+    void getState(double* state) const override
+    {
+        stage1.getState(state);
+        stage2.getState(state + stage1.getStateSize());
+    }
+
+    void setState(const double* state) override
+    {
+        stage1.setState(state);
+        stage2.setState(state + stage1.getStateSize());
+    }
+
+    /**
+     * @brief Normalises the output to unity gain at the peak of the pass band; on by default
+     * @param shouldApply Whether to apply the make-up gain
+     */
+    void setAutoGain(bool shouldApply)
+    {
+        applyAutoGain = shouldApply;
+        updateAutoGain();
+    }
+
+    bool getAutoGain() const { return applyAutoGain; }
+
+private:
+    void updateCutoffs()
+    {
+        // For a bandpass, the high-pass cutoff is below the center frequency
+        // and the low-pass cutoff is above the center frequency
+        double hpCutoff = cutoff / bandwidthRatio;
+        double lpCutoff = cutoff * bandwidthRatio;
+
+        // Limit the frequencies to valid ranges
+        hpCutoff = std::clamp(hpCutoff, 20.0, fs * 0.45);
+        lpCutoff = std::clamp(lpCutoff, 20.0, fs * 0.45);
+
+        stage1.setCutoff(hpCutoff); // High-pass filter
+        stage2.setCutoff(lpCutoff); // Low-pass filter
+        updateAutoGain();
+    }
+
+    // Folded into the high-pass output, so the make-up gain adds no work per sample
+    void updateAutoGain()
+    {
+        const double ratio = stage1.getStageCutoff() / stage2.getStageCutoff();
+        stage1.setOutputGain(applyAutoGain ? (1.0 + ratio) * (1.0 + ratio) : 1.0);
+    }
+
+    WDFRC2HighPassCascade stage1;
+    WDFRC2LowPassCascade  stage2;
+
+    double fs{44100.0}, cutoff{1000.0};
+    double bandwidthInOctaves{1.0};            // Default to 1 octave
+    double bandwidthRatio{1.4142135623730951}; // 2^(bandwidthInOctaves / 2), cached by setBandwidth()
+    bool   applyAutoGain{true};
+};
+
+/**
+ * @brief Second-order band pass filter from a single series RLC resonator using WDF
+ *
+ * A voltage source drives a resistor, an inductor and a capacitor in series and the output
+ * is taken across the resistor, giving H(s) = s R C / (s^2 L C + s R C + 1): unity gain at
+ * the centre frequency and 6 dB/octave skirts. One WDF tree with two reactive states replaces
+ * the four RC stages of WDFRCBandPass2nd, and the centre frequency and Q are set directly.
+ * The centre frequency is pre-warped, so the peak stays at the cutoff up to 0.45 Fs.
+ */
+class WDFRLCBandPass final : public WDFilter
+{
+public:
+    WDFRLCBandPass()
+        : r1(1.0e3) // R and L are tuned by setCutoff() and setQ()
+        , l1(0.25)
+        , c1(capacitance)
+        , s1(l1, c1)
+        , s2(r1, s1)
+        , inverter(s2)
+        , vin(inverter)
+    {}
+
+    void prepare(double Fs) override
+    {
+        fs = Fs;
+        l1.prepare(fs);
+        c1.prepare(fs);
+        cutoff = std::clamp(cutoff, 20.0, fs * 0.45);
+        updateComponentValues();
+    }
+
+    double processSample(double x) override
+    {
+        vin.setVoltage(x);
+
+        vin.incident(inverter.reflected());
+        inverter.incident(vin.reflected());
+
+        return wdft::voltage<double>(r1);
+    }
+
+    void processBlock(float* samples, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
+    }
+
+    void setCutoff(double fc) override
+    {
+        const double newCutoff = std::clamp(fc, 20.0, fs * 0.45);
+        if (newCutoff == cutoff)
+            return;
+
+        cutoff = newCutoff;
+        updateComponentValues();
+    }
+
+    /**
+     * @brief Sets the quality factor (centre frequency divided by the -3 dB bandwidth)
+     * @param newQ Quality factor, clamped to [0.1, 50]
+     */
+    void setQ(double newQ)
+    {
+        newQ = std::clamp(newQ, 0.1, 50.0);
+        if (newQ == q)
+            return;
+
+        q = newQ;
+        updateComponentValues();
+    }
+
+    double getQ() const { return q; }
+
+    /**
+     * @brief Sets Q from the distance between the -3 dB points, like setBandwidth() of the RC band-passes
+     * @param octaves Bandwidth in octaves (at least 0.1)
+     */
+    void setBandwidth(double octaves) override
+    {
+        octaves = std::max(0.1, octaves);
+        if (octaves == bandwidthInOctaves)
+            return;
+
+        bandwidthInOctaves = octaves;
+        const double ratio = std::pow(2.0, octaves);
+        setQ(std::sqrt(ratio) / (ratio - 1.0));
+    }
+
+    double getCutoff() const override { return cutoff; }
+
+    Type getType() const override { return Type::BandPass; }
+
+    Order getOrder() const override { return Order::Second; }
+
+    // The incident waves of the capacitor and the inductor, which they reflect at the next sample
+    int getStateSize() const override { return 2; }
+
+    void getState(double* state) const override
+    {
+        state[0] = c1.wdf.a;
+        state[1] = l1.wdf.a;
+    }
+
+    void setState(const double* state) override
+    {
+        c1.incident(state[0]);
+        l1.incident(state[1]);
+    }
+
+private:
+    static constexpr double capacitance = 1.0e-7; // 100 nF, as in the RC filters
+
+    void updateComponentValues()
+    {
+        // omega0 = 1 / sqrt(LC), Q = sqrt(L / C) / R
+        const double omega = 2.0 * fs * std::tan(wdf_core::MathConstants<double>::pi * cutoff / fs);
+        const double L     = 1.0 / (omega * omega * capacitance);
+        l1.setInductanceValue(L);
+        r1.setResistanceValue(std::sqrt(L / capacitance) / q);
+    }
+
+    wdft::ResistorT<double>                               r1;
+    wdft::InductorT<double>                               l1;
+    wdft::CapacitorT<double>                              c1;
+    wdft::WDFSeriesT<double, decltype(l1), decltype(c1)>  s1; // inner adaptor: its ports' polarity is flipped,
+    wdft::WDFSeriesT<double, decltype(r1), decltype(s1)>  s2; // so R, the output, sits on the outer one
+    wdft::PolarityInverterT<double, decltype(s2)>         inverter;
+    wdft::IdealVoltageSourceT<double, decltype(inverter)> vin;
+
+    double fs{44100.0}, cutoff{1000.0};
+    double q{1.4142135623730951}; // 1 octave between the -3 dB points
+    double bandwidthInOctaves{1.0};
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace wdf_core
+{
+
+    /**
+     * @brief Pole alignment of a higher-order cascade
+     */
+    enum class Alignment
+    {
+        Butterworth,  // maximally flat magnitude, -3 dB at the cutoff
+        Bessel,       // maximally flat group delay, normalised to -3 dB at the cutoff
+        LinkwitzRiley // two cascaded Butterworth filters of half the order, -6 dB at the cutoff; even orders only
+    };
+
+    static constexpr int maxCascadeOrder      = 12;
+    static constexpr int maxPrototypeSections = (maxCascadeOrder + 1) / 2;
+
+    /**
+     * @brief One section of a low-pass prototype normalised to a cutoff of 1 rad/s
+     */
+    struct PrototypeSection
+    {
+        double omega = 1.0; // pole (first order) or natural frequency (second order), relative to the cutoff
+        double q     = 0.0; // quality factor of a second-order section; 0 marks a first-order section
+
+        bool isFirstOrder() const noexcept { return q <= 0.0; }
+    };
+
+    /**
+     * @brief Normalised low-pass prototype, as a list of second-order sections plus at most one first-order section
+     */
+    struct CascadePrototype
+    {
+        std::array<PrototypeSection, maxPrototypeSections> sections{};
+        int                                                 numSections = 0;
+        int                                                 order       = 0;
+    };
+
+    /**
+     * @brief Component values of one series section driven by a voltage source
+     *
+     * The source drives R, L and C in series. The low-pass output is taken across C and the
+     * high-pass output across L; a first-order section has no inductor (L = 0) and its
+     * high-pass output is taken across R.
+     */
+    struct SectionComponents
+    {
+        double R = 0.0; // ohms
+        double L = 0.0; // henries
+        double C = 0.0; // farads
+    };
+
+    /**
+     * @brief Computes the normalised low-pass prototype of an alignment
+     * @param alignment Butterworth, Bessel or Linkwitz-Riley
+     * @param order Filter order, clamped to [1, maxCascadeOrder]; Linkwitz-Riley orders are rounded up to even
+     * @return Sections ordered by ascending Q, first-order section first
+     */
+    CascadePrototype designCascadePrototype(Alignment alignment, int order);
+
+    /**
+     * @brief Computes the components that place one prototype section at a given cutoff
+     * @param section Normalised prototype section
+     * @param highPass Whether the section is the high-pass transform of the prototype (s -> 1/s)
+     * @param cutoffRadians Analogue cutoff in rad/s (pre-warped by the caller where needed)
+     * @param capacitance Fixed capacitor value in farads; R and L are scaled around it
+     * @return Series R, L and C values
+     */
+    SectionComponents designSectionComponents(const PrototypeSection& section,
+                                              bool                    highPass,
+                                              double                  cutoffRadians,
+                                              double                  capacitance);
+
+    /**
+     * @brief Voltage a series section outputs
+     */
+    enum class SectionOutput
+    {
+        LowPass,  // across C
+        HighPass, // across L, or across R in a first-order section
+        AllPass   // source voltage minus twice the voltage across R: the numerator of the low-pass with s -> -s
+    };
+
+    /**
+     * @brief Coefficients of one series section in closed form
+     *
+     * The scattering of the series adaptor, with u = Vs - zL + zC and gX = R_X / (R_R + R_L + R_C),
+     * updates the reflected waves of the capacitor (zC) and inductor (-zL) as
+     * zC <- zC - 2 gC u and zL <- -zL - 2 gL u. The output is y = kU u + kC zC + kL zL.
+     */
+    struct SectionCoefficients
+    {
+        double dC = 0.0, dL = 0.0; // 2 gC, 2 gL
+        double kU = 0.0, kC = 0.0, kL = 0.0;
+    };
+
+    /**
+     * @brief The only state of a series section, 16 bytes
+     */
+    struct SectionState
+    {
+        double zC = 0.0, zL = 0.0;
+    };
+
+    /**
+     * @brief Advances one series section by one sample
+     * @param c Section coefficients
+     * @param s Section state
+     * @param x Source voltage
+     * @return Output voltage
+     */
+    inline double processSection(const SectionCoefficients& c, SectionState& s, double x) noexcept
+    {
+        const double u = x - s.zL + s.zC;
+        const double y = c.kU * u + c.kC * s.zC + c.kL * s.zL;
+        s.zC -= c.dC * u;
+        s.zL = -s.zL - c.dL * u;
+        return y;
+    }
+
+    /**
+     * @brief Computes the coefficients of one prototype section at a given cutoff and sample rate
+     * @param section Normalised prototype section
+     * @param output Low-pass, high-pass (with the high-pass components) or all-pass (with the low-pass components)
+     * @param cutoffRadians Analogue cutoff in rad/s (pre-warped by the caller where needed)
+     * @param sampleRate Sample rate in Hz
+     * @param capacitance Fixed capacitor value in farads
+     * @return Section coefficients
+     */
+    SectionCoefficients designSectionCoefficients(const PrototypeSection& section,
+                                                  SectionOutput           output,
+                                                  double                  cutoffRadians,
+                                                  double                  sampleRate,
+                                                  double                  capacitance);
+
+    /**
+     * @brief Make-up gain of a band-pass built from the high- and low-pass transforms of one prototype
+     *
+     * Stores the reciprocal of the peak magnitude of H_hp(s / a) H_lp(s / b) against the corner ratio
+     * b / a, from 1 to 2^12 in 1/32-octave steps. The peak depends only on that ratio, so one table per
+     * prototype serves every sample rate and centre frequency; ratios past the end read the last entry.
+     */
+    struct BandPassGainTable
+    {
+        static constexpr int    stepsPerOctave = 32;
+        static constexpr int    numOctaves     = 12;
+        static constexpr size_t size           = stepsPerOctave * numOctaves + 1;
+
+        std::array<double, size> gains{};
+
+        /**
+         * @brief Interpolates the make-up gain for a corner ratio (cubic, within 0.002 dB of the exact value)
+         * @param cornerRatio Low-pass corner over high-pass corner in rad/s, after any pre-warping
+         * @return Gain that brings the peak of the band-pass to unity
+         */
+        double getGain(double cornerRatio) const noexcept;
+    };
+
+    /**
+     * @brief Tabulates the band-pass make-up gain of a prototype
+     *
+     * The magnitude is evaluated from the same section components the filter builds, so the
+     * table matches the filter's transfer function rather than an approximation of it.
+     * @param prototype Prototype used for both the high- and the low-pass half
+     * @return Gains over the full ratio range
+     */
+    BandPassGainTable designBandPassGainTable(const CascadePrototype& prototype);
+
+} // namespace wdf_core
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include "WDFilters/CascadeDesign.h"
+#include "WDFilters/WDFilter.h"
+
+/**
+ * @brief Higher-order low-, high- or band-pass filter built from cascaded WDF sections
+ *
+ * Each section is a voltage source driving a series R-L-C loop (R-C for the optional
+ * first-order section), with component values from wdf_core::designSectionComponents().
+ * The low-pass output is the capacitor voltage and the high-pass output the inductor
+ * (or resistor) voltage. Instead of one chowdsp tree per section, the scattering of the
+ * series adaptor is written out in closed form (wdf_core::processSection()): with u = Vs - zL + zC,
+ *
+ *     zC <- zC - 2 gC u,   zL <- -zL - 2 gL u,   gX = R_X / (R_R + R_L + R_C)
+ *
+ * which is exactly what the wave-digital tree computes, with the reflected waves of the
+ * capacitor (zC) and inductor (-zL) as the only state. The states of all sections sit in one
+ * contiguous array (16 bytes per section), so a 12th-order cascade keeps its whole state in
+ * two cache lines and the coefficients in a few more.
+ *
+ * The band-pass is a high-pass followed by a low-pass of the same order and alignment, with
+ * corner frequencies half the bandwidth below and above the centre, like WDFRCBandPass1st/2nd.
+ * Its auto-gain reads the exact make-up gain for the current corners from a table built with the
+ * prototype and multiplies it into the output coefficients of the last section, which costs
+ * nothing per sample.
+ */
+class WDFCascadeFilter final : public WDFilter
+{
+public:
+    static constexpr int maxSections = 2 * wdf_core::maxPrototypeSections; // band-pass: high- and low-pass half
+
+    /**
+     * @param filterType Low-, high- or band-pass
+     * @param filterAlignment Pole alignment of each (half of the) filter
+     * @param filterOrder Order of the low- or high-pass, or of each half of the band-pass (1 to 12)
+     */
+    explicit WDFCascadeFilter(Type                filterType      = Type::LowPass,
+                              wdf_core::Alignment filterAlignment = wdf_core::Alignment::Butterworth,
+                              int                 filterOrder     = 4)
+        : type(filterType)
+        , alignment(filterAlignment)
+        , prototype(wdf_core::designCascadePrototype(filterAlignment, filterOrder))
+    {
+        numSections = type == Type::BandPass ? 2 * prototype.numSections : prototype.numSections;
+        if (type == Type::BandPass)
+            gainTable = wdf_core::designBandPassGainTable(prototype);
+    }
+
+    void prepare(double newSampleRate) override
+    {
+        sampleRate = newSampleRate;
+        states     = {};
+        cutoff     = std::clamp(cutoff, 20.0, sampleRate * 0.45);
+        updateCoefficients();
+    }
+
+    double processSample(double x) override
+    {
+        for (int i = 0; i < numSections; ++i)
+            x = wdf_core::processSection(coefficients[static_cast<size_t>(i)], states[static_cast<size_t>(i)], x);
+        return x;
+    }
+
+    void processBlock(float* samples, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
+    }
+
+    void setCutoff(double newFc) override
+    {
+        newFc = std::clamp(newFc, 20.0, sampleRate * 0.45);
+        if (newFc == cutoff)
+            return;
+
+        cutoff = newFc;
+        updateCoefficients();
+    }
+
+    /**
+     * @brief Sets the distance between the band-pass corners; ignored by low- and high-pass filters
+     * @param octaves Bandwidth in octaves (at least 0.1)
+     */
+    void setBandwidth(double octaves) override
+    {
+        octaves = std::max(0.1, octaves);
+        if (octaves == bandwidthInOctaves)
+            return;
+
+        bandwidthInOctaves = octaves;
+        bandwidthRatio     = std::pow(2.0, bandwidthInOctaves / 2.0);
+        if (type == Type::BandPass)
+            updateCoefficients();
+    }
+
+    double getBandwidth() const { return bandwidthInOctaves; }
+
+    /**
+     * @brief Normalises the band-pass to unity peak gain; on by default, ignored by low- and high-pass filters
+     * @param shouldApply Whether to apply the make-up gain
+     */
+    void setAutoGain(bool shouldApply)
+    {
+        if (shouldApply == applyAutoGain)
+            return;
+
+        applyAutoGain = shouldApply;
+        if (type == Type::BandPass)
+            updateCoefficients();
+    }
+
+    bool getAutoGain() const { return applyAutoGain; }
+
+    double getCutoff() const override { return cutoff; }
+
+    Type getType() const override { return type; }
+
+    /**
+     * @brief Coarse order for the WDFilter interface; getCascadeOrder() gives the exact order
+     */
+    Order getOrder() const override { return prototype.order >= 2 ? Order::Second : Order::First; }
+
+    int                 getCascadeOrder() const { return prototype.order; }
+    wdf_core::Alignment getAlignment() const { return alignment; }
+    int                 getNumSections() const { return numSections; }
+
+    // zC and zL of every section, in order
+    int getStateSize() const override { return 2 * numSections; }
+
+    void getState(double* state) const override
+    {
+        for (int i = 0; i < numSections; ++i)
+        {
+            state[2 * i]     = states[static_cast<size_t>(i)].zC;
+            state[2 * i + 1] = states[static_cast<size_t>(i)].zL;
+        }
+    }
+
+    void setState(const double* state) override
+    {
+        for (int i = 0; i < numSections; ++i)
+        {
+            states[static_cast<size_t>(i)].zC = state[2 * i];
+            states[static_cast<size_t>(i)].zL = state[2 * i + 1];
+        }
+    }
+
+private:
+    static constexpr double capacitance = 1.0e-7; // 100 nF, as in the RC filters
+
+    void updateCoefficients()
+    {
+        // Pre-warp so that the bilinear transform inside the reactances lands the cutoff exactly
+        auto warp = [this](double frequency) {
+            return 2.0 * sampleRate * std::tan(wdf_core::MathConstants<double>::pi * frequency / sampleRate);
+        };
+
+        if (type == Type::BandPass)
+        {
+            const double hp        = std::clamp(cutoff / bandwidthRatio, 20.0, sampleRate * 0.45);
+            const double lp        = std::clamp(cutoff * bandwidthRatio, 20.0, sampleRate * 0.45);
+            const double hpRadians = warp(hp);
+            const double lpRadians = warp(lp);
+            updateSections(0, true, hpRadians);
+            updateSections(prototype.numSections, false, lpRadians);
+
+            if (applyAutoGain)
+            {
+                const double                   gain = gainTable.getGain(lpRadians / hpRadians);
+                wdf_core::SectionCoefficients& last = coefficients[static_cast<size_t>(numSections - 1)];
+                last.kU *= gain;
+                last.kC *= gain;
+                last.kL *= gain;
+            }
+        }
+        else
+        {
+            updateSections(0, type == Type::HighPass, warp(cutoff));
+        }
+    }
+
+    void updateSections(int first, bool highPass, double cutoffRadians)
+    {
+        const auto output = highPass ? wdf_core::SectionOutput::HighPass : wdf_core::SectionOutput::LowPass;
+        for (int i = 0; i < prototype.numSections; ++i)
+        {
+            coefficients[static_cast<size_t>(first + i)] = wdf_core::designSectionCoefficients(
+                prototype.sections[static_cast<size_t>(i)], output, cutoffRadians, sampleRate, capacitance);
+        }
+    }
+
+    Type                       type;
+    wdf_core::Alignment        alignment;
+    wdf_core::CascadePrototype prototype;
+    int                        numSections = 0;
+
+    alignas(64) std::array<wdf_core::SectionState, maxSections> states{};
+    std::array<wdf_core::SectionCoefficients, maxSections>      coefficients{};
+    wdf_core::BandPassGainTable                                 gainTable{}; // band-pass only
+
+    double sampleRate{44100.0};
+    double cutoff{1000.0};
+    double bandwidthInOctaves{1.0};
+    double bandwidthRatio{1.4142135623730951}; // 2^(bandwidthInOctaves / 2)
+    bool   applyAutoGain{true};
+};
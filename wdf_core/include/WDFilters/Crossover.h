@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "WDFilters/CascadeDesign.h"
+#include "wdf_core/MathConstants.h"
+
+/**
+ * @brief Linkwitz-Riley multiband splitter built from the series WDF sections of WDFCascadeFilter
+ *
+ * The input is split at the lowest crossover into a low-pass band and a high-pass remainder, the
+ * remainder at the next crossover, and so on, so every stage of the high-pass path is computed
+ * once and shared by all the bands above it. At each crossover the low- and high-pass of order
+ * 2n (two Butterworth filters of order n in series) sum to the all-pass B(-s) / B(s) of the
+ * Butterworth denominator B, once the high-pass is multiplied by (-1)^n. Each band below a
+ * crossover gets that all-pass too, from sections with the Butterworth components and an
+ * all-pass output (wdf_core::SectionOutput::AllPass), so the bands sum to an all-pass: flat
+ * magnitude, whatever the crossover frequencies.
+ *
+ * All crossovers are pre-warped, like WDFCascadeFilter, so each band is exactly -6 dB at its
+ * crossovers. The state of every section sits in one array and nothing is allocated.
+ */
+class WDFCrossover
+{
+public:
+    static constexpr int maxBands = 8;
+
+    /**
+     * @param numberOfBands Number of output bands, clamped to [2, maxBands]
+     * @param filterOrder Linkwitz-Riley order of every crossover, rounded up to even and clamped to [2, 12]
+     */
+    explicit WDFCrossover(int numberOfBands = 3, int filterOrder = 4)
+        : numBands(std::clamp(numberOfBands, 2, maxBands))
+        , linkwitzRiley(wdf_core::designCascadePrototype(wdf_core::Alignment::LinkwitzRiley, std::max(2, filterOrder)))
+        , butterworth(wdf_core::designCascadePrototype(wdf_core::Alignment::Butterworth, linkwitzRiley.order / 2))
+    {
+        // Crossovers spread evenly in octaves between 200 Hz and 5 kHz until set
+        for (int i = 0; i < numBands - 1; ++i)
+            frequencies[static_cast<size_t>(i)] = 200.0 * std::pow(25.0, i / std::max(1.0, numBands - 2.0));
+
+        // Band b passes through the all-passes of crossovers b + 1 and up
+        for (int i = 0; i < numBands - 1; ++i)
+        {
+            splits[static_cast<size_t>(i)].lowPass  = takeSections(linkwitzRiley.numSections);
+            splits[static_cast<size_t>(i)].highPass = takeSections(linkwitzRiley.numSections);
+            for (int band = 0; band < i; ++band)
+                allPasses[static_cast<size_t>(band)][static_cast<size_t>(i)] = takeSections(butterworth.numSections);
+        }
+    }
+
+    /**
+     * @brief Sets the sample rate; clears the state
+     * @param newSampleRate Sample rate in Hz
+     */
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        piOverFs   = wdf_core::MathConstants<double>::pi / sampleRate;
+        reset();
+        for (auto& frequency : frequencies)
+            frequency = std::clamp(frequency, 20.0, sampleRate * 0.45);
+        updateCoefficients();
+    }
+
+    void reset() { states = {}; }
+
+    /**
+     * @brief Moves one crossover
+     *
+     * The bands sum to an all-pass for any frequencies, but they only split the spectrum in order
+     * while the crossovers ascend; out of order, the bands between them overlap.
+     * @param index Crossover index, 0 for the lowest (between bands 0 and 1)
+     * @param frequencyHz Crossover frequency in Hz, clamped to [20 Hz, 0.45 Fs]
+     */
+    void setCrossoverFrequency(int index, double frequencyHz)
+    {
+        if (index < 0 || index >= numBands - 1)
+            return;
+
+        const double newFrequency = std::clamp(frequencyHz, 20.0, sampleRate * 0.45);
+        if (newFrequency == frequencies[static_cast<size_t>(index)])
+            return;
+
+        frequencies[static_cast<size_t>(index)] = newFrequency;
+        updateCrossover(index);
+    }
+
+    double getCrossoverFrequency(int index) const { return frequencies[static_cast<size_t>(index)]; }
+
+    int getNumBands() const { return numBands; }
+    int getOrder() const { return linkwitzRiley.order; }
+
+    /**
+     * @brief Splits one sample
+     * @param x Input sample
+     * @param bands Receives getNumBands() outputs, lowest band first
+     */
+    void processSample(double x, double* bands)
+    {
+        for (int i = 0; i < numBands - 1; ++i)
+        {
+            const Split& split = splits[static_cast<size_t>(i)];
+            bands[i]           = processSections(split.lowPass, x);
+            x                  = processSections(split.highPass, x);
+
+            // The bands below this crossover get its all-pass
+            for (int band = 0; band < i; ++band)
+            {
+                const Chain& allPass = allPasses[static_cast<size_t>(band)][static_cast<size_t>(i)];
+                bands[band]          = processSections(allPass, bands[band]);
+            }
+        }
+        bands[numBands - 1] = x;
+    }
+
+    /**
+     * @brief Splits a block into one buffer per band
+     * @param input Input samples; may alias one of the band buffers
+     * @param bandOutputs getNumBands() buffers of numSamples samples, lowest band first
+     * @param numSamples Number of samples
+     */
+    void processBlock(const float* input, float* const* bandOutputs, int numSamples)
+    {
+        std::array<double, maxBands> bands{};
+        for (int n = 0; n < numSamples; ++n)
+        {
+            processSample(input[n], bands.data());
+            for (int band = 0; band < numBands; ++band)
+                bandOutputs[band][n] = static_cast<float>(bands[static_cast<size_t>(band)]);
+        }
+    }
+
+private:
+    static constexpr double capacitance = 1.0e-7; // 100 nF, as in the RC filters
+
+    // Crossovers, their low- and high-pass halves and the all-passes of the bands below them
+    static constexpr int maxAllPassSections = (wdf_core::maxPrototypeSections + 1) / 2; // Butterworth of half the order
+    static constexpr int maxSections        = (maxBands - 1) * 2 * wdf_core::maxPrototypeSections
+                                       + (maxBands - 1) * (maxBands - 2) / 2 * maxAllPassSections;
+
+    // A run of consecutive sections
+    struct Chain
+    {
+        int first = 0, count = 0;
+    };
+
+    struct Split
+    {
+        Chain lowPass, highPass;
+    };
+
+    Chain takeSections(int count)
+    {
+        const Chain chain{numSections, count};
+        numSections += count;
+        return chain;
+    }
+
+    double processSections(const Chain& chain, double x)
+    {
+        for (int i = chain.first; i < chain.first + chain.count; ++i)
+            x = wdf_core::processSection(coefficients[static_cast<size_t>(i)], states[static_cast<size_t>(i)], x);
+        return x;
+    }
+
+    void updateCoefficients()
+    {
+        for (int i = 0; i < numBands - 1; ++i)
+            updateCrossover(i);
+    }
+
+    void updateCrossover(int index)
+    {
+        // Pre-warp so that the bilinear transform inside the reactances lands the crossover exactly
+        const double frequency = frequencies[static_cast<size_t>(index)];
+        const double radians   = 2.0 * sampleRate * std::tan(piOverFs * frequency);
+
+        const Split& split = splits[static_cast<size_t>(index)];
+        designChain(split.lowPass, linkwitzRiley, wdf_core::SectionOutput::LowPass, radians);
+        designChain(split.highPass, linkwitzRiley, wdf_core::SectionOutput::HighPass, radians);
+        for (int band = 0; band < index; ++band)
+            designChain(allPasses[static_cast<size_t>(band)][static_cast<size_t>(index)],
+                        butterworth,
+                        wdf_core::SectionOutput::AllPass,
+                        radians);
+
+        // (-1)^n on the high-pass, folded into its last section, makes the pair sum to the all-pass
+        if ((linkwitzRiley.order / 2) % 2 != 0)
+        {
+            const int                      lastSection = split.highPass.first + split.highPass.count - 1;
+            wdf_core::SectionCoefficients& last        = coefficients[static_cast<size_t>(lastSection)];
+            last.kU                                    = -last.kU;
+            last.kC                                    = -last.kC;
+            last.kL                                    = -last.kL;
+        }
+    }
+
+    void designChain(const Chain&                      chain,
+                     const wdf_core::CascadePrototype& prototype,
+                     wdf_core::SectionOutput           output,
+                     double                            radians)
+    {
+        for (int i = 0; i < chain.count; ++i)
+        {
+            coefficients[static_cast<size_t>(chain.first + i)] = wdf_core::designSectionCoefficients(
+                prototype.sections[static_cast<size_t>(i)], output, radians, sampleRate, capacitance);
+        }
+    }
+
+    int                        numBands;
+    wdf_core::CascadePrototype linkwitzRiley, butterworth;
+
+    std::array<double, maxBands - 1>                      frequencies{};
+    std::array<Split, maxBands - 1>                       splits{};
+    std::array<std::array<Chain, maxBands - 1>, maxBands> allPasses{}; // [band][crossover above it]
+    int                                                   numSections = 0;
+
+    alignas(64) std::array<wdf_core::SectionState, maxSections> states{};
+    std::array<wdf_core::SectionCoefficients, maxSections>      coefficients{};
+
+    double sampleRate{44100.0}, piOverFs{wdf_core::MathConstants<double>::pi / 44100.0};
+};
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "WDFilters/WDFilter.h"
+#include "wdf_core/MathConstants.h"
+
+namespace wdf_core
+{
+
+    /**
+     * @brief Fixed-point sample formats: Q31 in 32-bit words, Q15 in 16-bit words
+     *
+     * Products and sums are formed in the wide type, twice the word size, and saturated back.
+     */
+    template <typename Word>
+    struct FixedPointFormat;
+
+    template <>
+    struct FixedPointFormat<int32_t>
+    {
+        using Wide                          = int64_t;
+        static constexpr int fractionalBits = 31;
+    };
+
+    template <>
+    struct FixedPointFormat<int16_t>
+    {
+        using Wide                          = int32_t;
+        static constexpr int fractionalBits = 15;
+    };
+
+    /**
+     * @brief Clamps a wide intermediate to the range of the word
+     */
+    template <typename Word>
+    constexpr Word saturate(typename FixedPointFormat<Word>::Wide x) noexcept
+    {
+        using Wide = typename FixedPointFormat<Word>::Wide;
+        return static_cast<Word>(std::clamp<Wide>(
+            x, Wide{std::numeric_limits<Word>::min()}, Wide{std::numeric_limits<Word>::max()}));
+    }
+
+    /**
+     * @brief Converts a sample in [-1, 1) to fixed point, rounding to nearest and saturating
+     */
+    template <typename Word>
+    Word toFixedPoint(double x) noexcept
+    {
+        const double scaled = std::ldexp(x, FixedPointFormat<Word>::fractionalBits);
+        const double limit  = std::ldexp(1.0, FixedPointFormat<Word>::fractionalBits);
+        return saturate<Word>(static_cast<typename FixedPointFormat<Word>::Wide>(
+            std::nearbyint(std::clamp(scaled, -limit, limit)))); // NaN maps to an implementation value, not UB
+    }
+
+    template <typename Word>
+    double fromFixedPoint(Word x) noexcept
+    {
+        return std::ldexp(static_cast<double>(x), -FixedPointFormat<Word>::fractionalBits);
+    }
+
+} // namespace wdf_core
+
+/**
+ * @brief First- and second-order RC low- and high-pass in fixed point (Q31 or Q15), saturating
+ *
+ * The circuits of WDFRCLowPass/WDFRCHighPass and their two-stage cascades, with the same
+ * component values and stage corners. With the ideal source at the root, each RC tree reduces to
+ * the capacitor's reflected wave z and the reflection coefficient G = R_C / (R + R_C):
+ *
+ *     v = G (x - z),   V_C = v + z,   z <- V_C + v
+ *
+ * with the low-pass output V_C and the high-pass output V_R = x - V_C. All of it runs on
+ * integers: G is stored as a mantissa and a shift (block floating point, so low cutoffs keep
+ * their precision), the product is rounded with first-order error feedback (the residue of each
+ * shift is added to the next product, so the integrator has no dead band and its DC is exact),
+ * and every sum saturates. The coefficients come from double products and quotients without
+ * fused operations, so the output is bit-exact on any compiler and platform with IEEE doubles and
+ * arithmetic right shifts of negative numbers, which all supported ones have.
+ *
+ * Scaling is chosen from the component values when the cutoff changes: the largest value any
+ * node reaches for a full-scale input (the state grows to max(1, R_C / R), a high-pass output to
+ * twice its input) sets the headroom bits, and the signal runs that many bits below full scale
+ * inside the filter. Q31 keeps 29 or more bits of resolution, Q15 13 or more.
+ *
+ * processSampleFixed()/processBlockFixed() take and return words in Q1.(fractional bits); the
+ * WDFilter interface converts from and to floating point around them.
+ */
+template <typename Word>
+class WDFRCFixedPoint final : public WDFilter
+{
+public:
+    using Format = wdf_core::FixedPointFormat<Word>;
+    using Wide   = typename Format::Wide;
+
+    static constexpr int fractionalBits = Format::fractionalBits;
+
+    /**
+     * @param filterType Low- or high-pass
+     * @param filterOrder One RC stage or two
+     */
+    explicit WDFRCFixedPoint(Type filterType = Type::LowPass, Order filterOrder = Order::First)
+        : type(filterType)
+        , order(filterOrder)
+    {
+        assert(type != Type::BandPass && "The fixed-point engine has low- and high-pass RC filters only");
+        if (type == Type::BandPass)
+            type = Type::LowPass;
+    }
+
+    void prepare(double newSampleRate) override
+    {
+        sampleRate = newSampleRate;
+        cutoff     = std::clamp(cutoff, 20.0, sampleRate * 0.45);
+        reset();
+        updateCoefficients();
+    }
+
+    /**
+     * @brief Clears the capacitor states and error-feedback residues
+     */
+    void reset() { stages = {}; }
+
+    double processSample(double x) override
+    {
+        return wdf_core::fromFixedPoint(processSampleFixed(wdf_core::toFixedPoint<Word>(x)));
+    }
+
+    void processBlock(float* samples, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
+    }
+
+    /**
+     * @brief Processes one fixed-point sample
+     * @param x Input in Q1.(fractional bits)
+     * @return Output in the same format, saturated
+     */
+    Word processSampleFixed(Word x)
+    {
+        // Down to the internal scale, rounding to nearest
+        Wide signal = headroomBits > 0 ? (Wide{x} + (Wide{1} << (headroomBits - 1))) >> headroomBits : Wide{x};
+
+        for (int i = 0; i < numStages; ++i)
+        {
+            Stage& s = stages[static_cast<size_t>(i)];
+
+            const Wide product = mantissa * (signal - s.z) + s.residue;
+            const Wide v       = product >> shift;
+            s.residue          = product - v * (Wide{1} << shift);
+
+            const Wide capacitor = wdf_core::saturate<Word>(v + s.z);
+            s.z                  = wdf_core::saturate<Word>(capacitor + v);
+            signal = type == Type::LowPass ? capacitor : wdf_core::saturate<Word>(signal - capacitor);
+        }
+
+        // Back to full scale; multiplying avoids shifting negative numbers left
+        return wdf_core::saturate<Word>(signal * (Wide{1} << headroomBits));
+    }
+
+    /**
+     * @brief Processes a block of fixed-point samples in place
+     * @param samples Buffer in Q1.(fractional bits)
+     * @param numSamples Number of samples in the buffer
+     */
+    void processBlockFixed(Word* samples, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = processSampleFixed(samples[i]);
+    }
+
+    void setCutoff(double newFc) override
+    {
+        newFc = std::clamp(newFc, 20.0, sampleRate * 0.45);
+        if (newFc == cutoff)
+            return;
+
+        cutoff = newFc;
+        updateCoefficients();
+    }
+
+    double getCutoff() const override { return cutoff; }
+
+    Type getType() const override { return type; }
+
+    Order getOrder() const override { return order; }
+
+    /**
+     * @brief Bits the signal runs below full scale inside the filter, chosen from the component values
+     */
+    int getHeadroomBits() const { return headroomBits; }
+
+    /**
+     * @brief Reflection coefficient G as quantised, for checking the coefficient precision
+     */
+    double getQuantisedCoefficient() const { return std::ldexp(static_cast<double>(mantissa), -shift); }
+
+private:
+    static constexpr double capacitance  = 1.0e-7; // 100 nF, as in the RC filters
+    static constexpr double cascadeRatio = 1.553;  // stage corners of the two-stage cascades
+
+    struct Stage
+    {
+        Wide z       = 0; // capacitor reflected wave, at the internal scale
+        Wide residue = 0; // error feedback of the coefficient product
+    };
+
+    void updateCoefficients()
+    {
+        numStages = order == Order::Second ? 2 : 1;
+
+        // The cascades spread their stage corners away from the cutoff, and the stages clamp them, like
+        // WDFRC2LowPassCascade/WDFRC2HighPassCascade
+        double stageCutoff = cutoff;
+        if (numStages == 2)
+            stageCutoff = type == Type::LowPass ? cutoff * cascadeRatio : cutoff / cascadeRatio;
+        stageCutoff = std::clamp(stageCutoff, 20.0, sampleRate * 0.45);
+
+        const double R  = 1.0 / (2.0 * wdf_core::MathConstants<double>::pi * stageCutoff * capacitance);
+        const double rC = 1.0 / (2.0 * capacitance * sampleRate);
+        const double G  = rC / (R + rC);
+
+        // Mantissa in [2^(F - 2), 2^(F - 1)), so its product with the difference of two words plus a residue
+        // below 2^shift fits the wide type
+        const int previousShift = shift;
+        shift                   = fractionalBits - 1;
+        while (std::ldexp(G, shift + 1) < std::ldexp(1.0, fractionalBits - 1) && shift < 2 * fractionalBits - 2)
+            ++shift;
+        mantissa = static_cast<Wide>(std::nearbyint(std::ldexp(G, shift)));
+
+        // Largest node value for a full-scale input: the state reaches max(1, R_C / R) times the stage input,
+        // V_C at most as much, and V_R = x - V_C the sum of the two
+        const double stateGain = std::max(1.0, rC / R);
+        const double stageGain = type == Type::LowPass ? stateGain : 1.0 + stateGain;
+        double       bound     = stateGain;
+        double       input     = 1.0;
+        for (int i = 0; i < numStages; ++i)
+        {
+            bound = std::max(bound, input * std::max(stateGain, stageGain));
+            input *= stageGain;
+        }
+
+        const int previousHeadroom = headroomBits;
+        headroomBits               = 0;
+        while (std::ldexp(1.0, headroomBits) < bound && headroomBits < fractionalBits - 8)
+            ++headroomBits;
+
+        // Keep the states' values when the internal scale moves, and the residues' (fractions of 2^shift)
+        // when the coefficient's shift does
+        for (auto& stage : stages)
+        {
+            if (headroomBits < previousHeadroom)
+                stage.z = wdf_core::saturate<Word>(stage.z * (Wide{1} << (previousHeadroom - headroomBits)));
+            else if (headroomBits > previousHeadroom)
+                stage.z >>= headroomBits - previousHeadroom;
+
+            if (headroomBits != previousHeadroom)
+                stage.residue = 0;
+            else if (shift < previousShift)
+                stage.residue >>= previousShift - shift;
+            else
+                stage.residue *= Wide{1} << (shift - previousShift);
+        }
+    }
+
+    Type  type;
+    Order order;
+
+    std::array<Stage, 2> stages{};
+    int                  numStages{1};
+    Wide                 mantissa{0};
+    int                  shift{fractionalBits};
+    int                  headroomBits{1};
+
+    double sampleRate{44100.0};
+    double cutoff{1000.0};
+};
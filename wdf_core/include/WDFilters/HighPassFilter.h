@@ -8,7 +8,7 @@
  * Implementation of a first-order high pass filter using a series capacitor
  * followed by a shunt resistor.
  */
-class WDFRCHighPass : public WDFilter
+class WDFRCHighPass final : public WDFilter
 {
 public:
     WDFRCHighPass()
@@ -37,12 +37,18 @@ public:
         vin.incident(inverter.reflected());
         inverter.incident(vin.reflected());
 
-        return wdft::voltage<double>(r1); // output at the resistor
+        return halfOutputGain * (r1.wdf.a + r1.wdf.b); // wdft::voltage(r1) with the output gain folded in
+    }
+
+    void processBlock(float* samples, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
     }
 
     void setCutoff(double newFc) override
     {
-        cutoff = juce::jlimit(20.0, sampleRate * 0.45, newFc);
+        cutoff = std::clamp(newFc, 20.0, sampleRate * 0.45);
         updateComponentValues();
     }
 
@@ -52,11 +58,22 @@ public:
 
     Order getOrder() const override { return Order::First; }
 
+    // The capacitor's incident wave, which it reflects at the next sample, is the only state
+    int  getStateSize() const override { return 1; }
+    void getState(double* state) const override { state[0] = c1.wdf.a; }
+    void setState(const double* state) override { c1.incident(state[0]); }
+
+    /**
+     * @brief Scales the output; merged into the wave-to-voltage conversion, so it costs nothing per sample
+     * @param gain Linear gain
+     */
+    void setOutputGain(double gain) { halfOutputGain = 0.5 * gain; }
+
 private:
     void updateComponentValues()
     {
         constexpr double C = 1.0e-7;                                                     // farads
-        const double     R = 1.0 / (2.0 * juce::MathConstants<double>::pi * cutoff * C); // from fc formula
+        const double     R = 1.0 / (2.0 * wdf_core::MathConstants<double>::pi * cutoff * C); // from fc formula
         r1.setResistanceValue(R);
     }
 
@@ -70,6 +87,7 @@ private:
     // state
     double sampleRate{44100.0};
     double cutoff{1000.0};
+    double halfOutputGain{0.5};
 };
 
 /**
@@ -78,7 +96,7 @@ private:
  * Implementation of a second-order high pass filter by cascading
  * two first-order high pass filter stages.
  */
-class WDFRC2HighPassCascade : public WDFilter
+class WDFRC2HighPassCascade final : public WDFilter
 {
 public:
     void prepare(double Fs) override
@@ -90,9 +108,15 @@ public:
 
     double processSample(double x) override { return stage2.processSample(stage1.processSample(x)); }
 
+    void processBlock(float* samples, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
+    }
+
     void setCutoff(double fc) override
     {
-        cutoff = juce::jlimit(20.0, fs * 0.45, fc);
+        cutoff = std::clamp(fc, 20.0, fs * 0.45);
         stage1.setCutoff(cutoff / _k);
         stage2.setCutoff(cutoff / _k);
     }
@@ -103,6 +127,32 @@ public:
 
     Order getOrder() const override { return Order::Second; }
 
+    int getStateSize() const override { return 2; }
+
+    void getState(double* state) const override
+    {
+        stage1.getState(state);
+        stage2.getState(state + 1);
+    }
+
+    void setState(const double* state) override
+    {
+        stage1.setState(state);
+        stage2.setState(state + 1);
+    }
+
+    /**
+     * @brief Corner frequency of each first-order stage, spread below getCutoff() by the cascade factor
+     * @return Stage cutoff in Hz
+     */
+    double getStageCutoff() const { return stage1.getCutoff(); }
+
+    /**
+     * @brief Scales the output at no per-sample cost, see WDFRCHighPass::setOutputGain()
+     * @param gain Linear gain
+     */
+    void setOutputGain(double gain) { stage2.setOutputGain(gain); }
+
 private:
     WDFRCHighPass stage1, stage2;
     double        fs{44100.0}, cutoff{1000.0}, _k{1.553};
@@ -9,7 +9,7 @@
  * followed by a shunt capacitor.
  */
 // First-order WDF low-pass for JUCE
-class WDFRCLowPass : public WDFilter
+class WDFRCLowPass final : public WDFilter
 {
 public:
     WDFRCLowPass()
@@ -40,9 +40,15 @@ public:
         return wdft::voltage<double>(c1); // output at the cap
     }
 
+    void processBlock(float* samples, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
+    }
+
     void setCutoff(double newFc) override
     {
-        cutoff = juce::jlimit(20.0, sampleRate * 0.45, newFc);
+        cutoff = std::clamp(newFc, 20.0, sampleRate * 0.45);
         updateComponentValues();
     }
 
@@ -52,11 +58,16 @@ public:
 
     Order getOrder() const override { return Order::First; }
 
+    // The capacitor's incident wave, which it reflects at the next sample, is the only state
+    int  getStateSize() const override { return 1; }
+    void getState(double* state) const override { state[0] = c1.wdf.a; }
+    void setState(const double* state) override { c1.incident(state[0]); }
+
 private:
     void updateComponentValues()
     {
         constexpr double C = 1.0e-7;                                                     // farads
-        const double     R = 1.0 / (2.0 * juce::MathConstants<double>::pi * cutoff * C); // from fc formula
+        const double     R = 1.0 / (2.0 * wdf_core::MathConstants<double>::pi * cutoff * C); // from fc formula
         r1.setResistanceValue(R);
     }
 
@@ -72,7 +83,7 @@ private:
     double cutoff{1000.0};
 };
 
-class WDFRC2LowPassCascade : public WDFilter
+class WDFRC2LowPassCascade final : public WDFilter
 {
 public:
     void prepare(double Fs) override
@@ -84,9 +95,15 @@ public:
 
     double processSample(double x) override { return stage2.processSample(stage1.processSample(x)); }
 
+    void processBlock(float* samples, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
+    }
+
     void setCutoff(double fc) override
     {
-        cutoff = juce::jlimit(20.0, fs * 0.45, fc);
+        cutoff = std::clamp(fc, 20.0, fs * 0.45);
         stage1.setCutoff(cutoff * _k);
         stage2.setCutoff(cutoff * _k);
     }
@@ -97,6 +114,26 @@ public:
 
     Order getOrder() const override { return Order::Second; }
 
+    int getStateSize() const override { return 2; }
+
+    void getState(double* state) const override
+    {
+        stage1.getState(state);
+        stage2.getState(state + 1);
+    }
+
+    void setState(const double* state) override
+    {
+        stage1.setState(state);
+        stage2.setState(state + 1);
+    }
+
+    /**
+     * @brief Corner frequency of each first-order stage, spread above getCutoff() by the cascade factor
+     * @return Stage cutoff in Hz
+     */
+    double getStageCutoff() const { return stage1.getCutoff(); }
+
 private:
     WDFRCLowPass stage1, stage2;
     double       fs{44100.0}, cutoff{1000.0}, _k{1.553};
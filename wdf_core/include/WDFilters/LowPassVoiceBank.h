@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "wdf_core/MathConstants.h"
+
+/**
+ * @brief Many first-order RC low-pass filters (one per synth voice) in structure-of-arrays layout
+ *
+ * Each voice is the circuit of WDFRCLowPass. With the ideal voltage source at the root, its
+ * tree reduces to the capacitor's reflected wave z and the reflection coefficient
+ * G = R_C / (R + R_C) = g / (1 + g), where g = pi fc / fs for the RC values WDFRCLowPass picks:
+ *
+ *     v = G (x - z),   y = v + z,   z <- y + v
+ *
+ * y being the capacitor voltage. The coefficients and states of all voices sit in contiguous
+ * float arrays, and the active voices are kept packed at the front, so one sample of every
+ * active voice is a single loop over adjacent lanes that the compiler turns into SIMD. The
+ * voices' own buffers are transposed through a small scratch frame to make that possible.
+ *
+ * prepare() allocates for the maximum number of voices; activating, deactivating and retuning
+ * voices afterwards never allocates and is safe on the audio thread.
+ */
+class WDFRCLowPassVoiceBank
+{
+public:
+    static constexpr int lanes        = 8; // voices per SIMD group; capacity is a multiple of this
+    static constexpr int subBlockSize = 32; // samples transposed at a time
+
+    /**
+     * @brief Allocates the bank and deactivates every voice
+     * @param newSampleRate Sample rate in Hz
+     * @param maxVoices Largest voice index plus one
+     */
+    void prepare(double newSampleRate, int maxVoices)
+    {
+        sampleRate = newSampleRate;
+        numVoices  = std::max(0, maxVoices);
+        capacity   = (numVoices + lanes - 1) / lanes * lanes;
+        numActive  = 0;
+
+        const auto size = static_cast<size_t>(capacity);
+        gains.assign(size, 0.0f);
+        states.assign(size, 0.0f);
+        cutoffs.assign(static_cast<size_t>(numVoices), 1000.0);
+        slotOfVoice.assign(static_cast<size_t>(numVoices), -1);
+        voiceOfSlot.assign(size, -1);
+    }
+
+    /**
+     * @brief Starts a voice with a cleared state; restarts it if it is already active
+     * @param voice Voice index, below the maxVoices given to prepare()
+     * @param cutoffHz Cutoff frequency in Hz
+     * @return False if the voice index is out of range
+     */
+    bool activateVoice(int voice, double cutoffHz)
+    {
+        if (voice < 0 || voice >= numVoices)
+            return false;
+
+        int& slot = slotOfVoice[static_cast<size_t>(voice)];
+        if (slot < 0)
+        {
+            slot                                   = numActive++;
+            voiceOfSlot[static_cast<size_t>(slot)] = voice;
+        }
+
+        states[static_cast<size_t>(slot)] = 0.0f;
+        setCutoff(voice, cutoffHz);
+        return true;
+    }
+
+    /**
+     * @brief Stops a voice; the last active voice moves into its slot to keep the active voices packed
+     * @param voice Voice index
+     */
+    void deactivateVoice(int voice)
+    {
+        if (!isVoiceActive(voice))
+            return;
+
+        const auto slot = static_cast<size_t>(slotOfVoice[static_cast<size_t>(voice)]);
+        const auto last = static_cast<size_t>(--numActive);
+
+        gains[slot]       = gains[last];
+        states[slot]      = states[last];
+        voiceOfSlot[slot] = voiceOfSlot[last];
+        slotOfVoice[static_cast<size_t>(voiceOfSlot[slot])] = static_cast<int>(slot);
+        slotOfVoice[static_cast<size_t>(voice)]             = -1;
+
+        // A free slot inside the last SIMD group must produce silence: G = 0 keeps v and y at zero
+        gains[last]       = 0.0f;
+        states[last]      = 0.0f;
+        voiceOfSlot[last] = -1;
+    }
+
+    bool isVoiceActive(int voice) const
+    {
+        return voice >= 0 && voice < numVoices && slotOfVoice[static_cast<size_t>(voice)] >= 0;
+    }
+
+    int getNumActiveVoices() const { return numActive; }
+    int getMaxVoices() const { return numVoices; }
+
+    /**
+     * @brief Sets the cutoff of one voice; active or not, the value is kept for getCutoff()
+     * @param voice Voice index
+     * @param cutoffHz Cutoff frequency in Hz, clamped to [20 Hz, 0.45 Fs]
+     */
+    void setCutoff(int voice, double cutoffHz)
+    {
+        if (voice < 0 || voice >= numVoices)
+            return;
+
+        const double cutoff                 = std::clamp(cutoffHz, 20.0, sampleRate * 0.45);
+        cutoffs[static_cast<size_t>(voice)] = cutoff;
+
+        const int slot = slotOfVoice[static_cast<size_t>(voice)];
+        if (slot >= 0)
+        {
+            const double g                   = wdf_core::MathConstants<double>::pi * cutoff / sampleRate;
+            gains[static_cast<size_t>(slot)] = static_cast<float>(g / (1.0 + g));
+        }
+    }
+
+    double getCutoff(int voice) const { return cutoffs[static_cast<size_t>(voice)]; }
+
+    /**
+     * @brief Clears the state of every voice
+     */
+    void reset() { std::fill(states.begin(), states.end(), 0.0f); }
+
+    /**
+     * @brief Filters the buffers of all active voices in place
+     * @param voiceBuffers One buffer per voice index; entries of inactive voices are not touched and may be null
+     * @param numSamples Number of samples in each buffer
+     */
+    void processBlock(float* const* voiceBuffers, int numSamples)
+    {
+        for (int first = 0; first < numActive; first += lanes)
+            processGroup(voiceBuffers, first, numSamples);
+    }
+
+private:
+    // One SIMD group of voices: sub-blocks of their buffers are transposed into frames of adjacent
+    // lanes, the states stay in registers, and the fixed-length lane loop vectorises
+    void processGroup(float* const* voiceBuffers, int first, int numSamples)
+    {
+        const int numLanes = std::min(lanes, numActive - first);
+
+        float g[lanes], z[lanes];
+        for (int l = 0; l < lanes; ++l)
+        {
+            g[l] = gains[static_cast<size_t>(first + l)];
+            z[l] = states[static_cast<size_t>(first + l)];
+        }
+
+        float unused[subBlockSize] = {}; // stands in for the buffers of free lanes, whose G is 0
+        for (int start = 0; start < numSamples; start += subBlockSize)
+        {
+            const int length = std::min(subBlockSize, numSamples - start);
+
+            float* buffers[lanes];
+            for (int l = 0; l < lanes; ++l)
+                buffers[l] = l < numLanes ? voiceBuffers[voiceOfSlot[static_cast<size_t>(first + l)]] + start : unused;
+
+            float frames[subBlockSize][lanes];
+            for (int n = 0; n < length; ++n)
+                for (int l = 0; l < lanes; ++l)
+                    frames[n][l] = buffers[l][n];
+
+            for (int n = 0; n < length; ++n)
+            {
+                for (int l = 0; l < lanes; ++l)
+                {
+                    const float v = g[l] * (frames[n][l] - z[l]);
+                    const float y = v + z[l];
+                    z[l]          = y + v;
+                    frames[n][l]  = y;
+                }
+            }
+
+            for (int n = 0; n < length; ++n)
+                for (int l = 0; l < lanes; ++l)
+                    buffers[l][n] = frames[n][l];
+        }
+
+        for (int l = 0; l < lanes; ++l)
+            states[static_cast<size_t>(first + l)] = z[l];
+    }
+
+    double sampleRate{44100.0};
+    int    numVoices{0}, capacity{0}, numActive{0};
+
+    // Indexed by slot; slots [0, numActive) hold the active voices
+    std::vector<float> gains, states;
+    std::vector<int>   voiceOfSlot;
+
+    // Indexed by voice
+    std::vector<double> cutoffs;
+    std::vector<int>    slotOfVoice; // -1 when inactive
+};
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "WDFilters/WDFilter.h"
+
+/**
+ * @brief Rail saturation of the op-amp of a Sallen-Key stage, normalised to rails at +-1
+ *
+ * Linear is the ideal amplifier. Fast is linear up to half the rails and bends into them along
+ * a rational curve, h + h t / (1 + t) with t = (|x| - h) / h and h = 1/2, with matching slope at
+ * the knee; on that curve the Sallen-Key loop equation is a quadratic with a closed-form root.
+ * Accurate uses std::tanh.
+ */
+struct OpAmpModel
+{
+    enum class Accuracy
+    {
+        Linear,  // ideal amplifier, no rails
+        Fast,    // linear to half the rails, rational knee above, solved in closed form
+        Accurate // std::tanh, solved by Newton's method
+    };
+
+    static constexpr double knee = 0.5; // Fast: end of the linear region, as a fraction of the rails
+
+    template <Accuracy accuracy>
+    static double saturate(double x)
+    {
+        if constexpr (accuracy == Accuracy::Linear)
+            return x;
+        else if constexpr (accuracy == Accuracy::Fast)
+        {
+            const double t = std::max(0.0, std::abs(x) - knee);
+            return std::copysign(std::min(std::abs(x), knee) + knee * t / (knee + t), x);
+        }
+        else
+            return std::tanh(x);
+    }
+};
+
+/**
+ * @brief Equal-component Sallen-Key low-pass whose op-amp saturates at its rails inside the feedback loop
+ *
+ * The input drives R1 and R2 in series into C2 at the non-inverting input; C1 feeds the op-amp
+ * output back to the junction of the resistors. The amplifier has the finite gain K set by its
+ * feedback divider, and that gain sets the resonance: with equal parts, Q = 1 / (3 - K). Its
+ * output saturates at the rails, so a loud or resonant signal is limited inside the loop, which
+ * pulls the resonance down and shifts the response, rather than being clipped after a linear
+ * filter.
+ *
+ * Both capacitors are trapezoidal integrators with a pre-warped cutoff (the bilinear transform of
+ * the circuit, as in the WDF classes) and the loop is solved without a unit delay. That leaves
+ * one equation per sample in the voltage u at the non-inverting input,
+ *     (1 + 3g + g^2) u - g rail sat(K u / rail) = c,
+ * with c built from the input and the two states. It is linear for Accuracy::Linear. Above the
+ * knee of Accuracy::Fast it is a quadratic, solved exactly with one square root and no
+ * iteration. For tanh it is monotonic in u and solved by Newton's method to convergence.
+ *
+ * GBW and slew rate are not modelled: for a TL072 the open-loop pole (3 MHz) and the slew limit
+ * (about 270 V per sample at 48 kHz) lie far outside the audio band and the rails.
+ * The output is divided by K, so the passband gain is unity as for the other low-passes.
+ */
+class SallenKeyLowPass final : public WDFilter
+{
+public:
+    using Accuracy = OpAmpModel::Accuracy;
+
+    /**
+     * @param modelAccuracy Saturation of the op-amp; Linear for the ideal circuit
+     */
+    explicit SallenKeyLowPass(Accuracy modelAccuracy = Accuracy::Fast)
+        : accuracy(modelAccuracy)
+    {}
+
+    void prepare(double newSampleRate) override
+    {
+        sampleRate = newSampleRate;
+        cutoff     = std::clamp(cutoff, 20.0, sampleRate * 0.45);
+        reset();
+        updateCoefficients();
+    }
+
+    /**
+     * @brief Clears the capacitor states
+     */
+    void reset()
+    {
+        s1 = 0.0;
+        s2 = 0.0;
+    }
+
+    double processSample(double x) override
+    {
+        switch (accuracy)
+        {
+        case Accuracy::Linear:
+            return processSample<Accuracy::Linear>(x);
+        case Accuracy::Fast:
+            return processSample<Accuracy::Fast>(x);
+        case Accuracy::Accurate:
+            return processSample<Accuracy::Accurate>(x);
+        }
+        return 0.0;
+    }
+
+    void processBlock(float* samples, int numSamples) override
+    {
+        // One branch per block; the sample loop is then free of virtual calls
+        switch (accuracy)
+        {
+        case Accuracy::Linear:
+            processBlock<Accuracy::Linear>(samples, numSamples);
+            break;
+        case Accuracy::Fast:
+            processBlock<Accuracy::Fast>(samples, numSamples);
+            break;
+        case Accuracy::Accurate:
+            processBlock<Accuracy::Accurate>(samples, numSamples);
+            break;
+        }
+    }
+
+    void setCutoff(double newFc) override
+    {
+        newFc = std::clamp(newFc, 20.0, sampleRate * 0.45);
+        if (newFc == cutoff)
+            return;
+
+        cutoff = newFc;
+        updateCoefficients();
+    }
+
+    /**
+     * @brief Sets the resonance through the amplifier gain, K = 3 - 1 / Q
+     * @param newQ Quality factor, clamped to [0.5, 10] (K from 1, the unity-gain follower, to 2.9)
+     */
+    void setQ(double newQ)
+    {
+        newQ = std::clamp(newQ, 0.5, 10.0);
+        if (newQ == q)
+            return;
+
+        q    = newQ;
+        gain = 3.0 - 1.0 / q;
+        updateCoefficients();
+    }
+
+    double getQ() const { return q; }
+
+    /**
+     * @brief Sets the level into the circuit; the output is scaled back by the inverse
+     * @param decibels Drive in dB; at 0 dB a full-scale signal is 1 V against the rails
+     */
+    void setDrive(double decibels)
+    {
+        drive        = std::pow(10.0, decibels / 20.0);
+        inverseDrive = 1.0 / drive;
+        updateCoefficients();
+    }
+
+    /**
+     * @brief Sets the op-amp's output swing
+     * @param railVolts Output swing in volts, symmetric around ground (default: 4 V)
+     */
+    void setRails(double railVolts)
+    {
+        rail = std::max(1.0e-3, railVolts);
+        updateCoefficients();
+    }
+
+    double getCutoff() const override { return cutoff; }
+
+    Type getType() const override { return Type::LowPass; }
+
+    Order getOrder() const override { return Order::Second; }
+
+    // Only the ideal circuit is linear
+    int getStateSize() const override { return accuracy == Accuracy::Linear ? 2 : 0; }
+
+    void getState(double* state) const override
+    {
+        state[0] = s1;
+        state[1] = s2;
+    }
+
+    void setState(const double* state) override
+    {
+        s1 = state[0];
+        s2 = state[1];
+    }
+
+private:
+    template <Accuracy modelAccuracy>
+    double processSample(double x)
+    {
+        x *= drive;
+        const double gx = g * x;
+        const double c  = g * (gx + s1) + b2 * s2;
+
+        // u, the voltage across C2, from a u - g rail sat(K u / rail) = c
+        double u;
+        if constexpr (modelAccuracy == Accuracy::Linear)
+            u = c * inverseLinearDenominator;
+        else if constexpr (modelAccuracy == Accuracy::Fast)
+        {
+            // In v = K u / rail, with C = |c| / rail and h the knee: below the knee v = C / (a / K - g); above it,
+            // z = v - h solves (a / K) z^2 + (h (a / K - g) - C') z - h C' = 0 with C' = C - h (a / K - g) > 0.
+            // The root is odd in c. Dividing by the constant 2a / K rather than using the other root form keeps the
+            // division off the sample-to-sample chain, at an absolute error near 1e-16 rail
+            const double scaledC = gOverRail * (gx + s1) + b2OverRail * s2; // c / rail, computed alongside c
+            const double absC    = std::abs(scaledC);
+            const double excess  = std::max(0.0, absC - kneeLinearTerm);
+            const double linear  = kneeLinearTerm - excess;
+            const double z       = (std::sqrt(linear * linear + fourKneeAOverGain * excess) - linear) * gainOverTwoA;
+            const double v       = std::min(absC * inverseLinearTerm, OpAmpModel::knee) + z;
+            u                    = railOverGain * std::copysign(v, scaledC);
+        }
+        else
+        {
+            // |sat| <= 1 brackets the root; Newton from the clamped linear solution converges in a few steps
+            u = std::clamp(c * inverseLinearDenominator, (c - gRail) * inverseA, (c + gRail) * inverseA);
+            for (int i = 0; i < maxIterations; ++i)
+            {
+                const double t    = std::tanh(gainOverRail * u);
+                const double step = (a * u - gRail * t - c) / (a - gGain * (1.0 - t * t));
+                u -= step;
+                if (std::abs(step) < tolerance)
+                    break;
+            }
+        }
+
+        // g y = a u - c for every model, so the voltage across C1, (g (x + u - 2y) + s1) / (1 + 2g), needs
+        // only u, and the op-amp output stays off the recursion
+        const double u1 = (gx + 2.0 * c + s1 + gMinusTwoA * u) * inverseB2;
+        s1              = 2.0 * u1 - s1;
+        s2              = 2.0 * u - s2;
+
+        return (a * u - c) * outputScale;
+    }
+
+    template <Accuracy modelAccuracy>
+    void processBlock(float* samples, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample<modelAccuracy>(samples[i]));
+    }
+
+    void updateCoefficients()
+    {
+        g                        = std::tan(wdf_core::MathConstants<double>::pi * cutoff / sampleRate);
+        a                        = 1.0 + g * (3.0 + g);
+        b2                       = 1.0 + 2.0 * g;
+        inverseA                 = 1.0 / a;
+        inverseB2                = 1.0 / b2;
+        inverseLinearDenominator = 1.0 / (a - g * gain);
+        gMinusTwoA               = g - 2.0 * a;
+        gGain                    = g * gain;
+        gRail                    = g * rail;
+        gOverRail                = g / rail;
+        b2OverRail               = b2 / rail;
+        gainOverRail             = gain / rail;
+        railOverGain             = rail / gain;
+        kneeLinearTerm           = OpAmpModel::knee * (a / gain - g);
+        inverseLinearTerm        = gain / (a - g * gain);
+        fourKneeAOverGain        = 4.0 * OpAmpModel::knee * a / gain;
+        gainOverTwoA             = 0.5 * gain / a;
+        outputScale              = inverseDrive / (g * gain); // y = (a u - c) / g, divided by K and the drive
+    }
+
+    static constexpr int    maxIterations = 16;
+    static constexpr double tolerance     = 1.0e-10; // volts
+
+    Accuracy accuracy;
+
+    double s1{0.0}, s2{0.0}; // capacitor states (C1, C2)
+
+    double sampleRate{44100.0}, cutoff{1000.0};
+    double q{0.7071067811865476}, gain{1.5857864376269049}; // Butterworth: K = 3 - sqrt(2)
+    double rail{4.0}, drive{1.0}, inverseDrive{1.0};
+
+    double g{0.0}, a{1.0}, b2{1.0}, inverseA{1.0}, inverseB2{1.0}, inverseLinearDenominator{1.0}, gMinusTwoA{-2.0};
+    double gGain{0.0}, gRail{0.0}, gOverRail{0.0}, b2OverRail{0.25}, gainOverRail{0.4}, railOverGain{2.5};
+    double kneeLinearTerm{0.5}, inverseLinearTerm{1.0}, fourKneeAOverGain{2.0}, gainOverTwoA{0.5}, outputScale{1.0};
+};
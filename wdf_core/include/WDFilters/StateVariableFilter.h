@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cmath>
+
+#include "WDFilters/WDFilter.h"
+
+/**
+ * @brief Second-order state-variable filter with topology-preserving trapezoidal integrators
+ *
+ * The analogue SVF loop (two integrators, feedback k = 1 / Q) is discretised with trapezoidal
+ * integrators and solved without a unit delay in the feedback path, so, like the WDF classes,
+ * it is the bilinear transform of its analogue circuit. One state update yields the low-, high-
+ * and band-pass outputs together; processSample() returns the one selected by the type, and
+ * processOutputs() all three. The band-pass output is scaled to unity peak gain.
+ *
+ * Unlike the WDF trees, a cutoff change touches no impedances: the coefficients follow from
+ * g = tan(pi fc / fs) and k alone. g comes from a [5/4] Pade approximant (within 2.5e-5 of tan()
+ * up to 0.45 Fs) whose division is shared with the coefficient normalisation, so a cutoff update
+ * costs a handful of multiplies and one division and can run every sample through
+ * processSample(x, cutoffHz) or processBlockModulated().
+ */
+class StateVariableFilter final : public WDFilter
+{
+public:
+    /**
+     * @brief All three responses from one state update
+     */
+    struct Outputs
+    {
+        double lowPass  = 0.0;
+        double highPass = 0.0;
+        double bandPass = 0.0; // unity gain at the cutoff
+    };
+
+    /**
+     * @param filterType Output returned by processSample()
+     */
+    explicit StateVariableFilter(Type filterType = Type::LowPass)
+        : type(filterType)
+        , mixInput(filterType == Type::HighPass ? 1.0 : 0.0)
+        , mixBand(filterType == Type::BandPass ? 1.0 : (filterType == Type::HighPass ? -1.0 : 0.0))
+        , mixLow(filterType == Type::BandPass ? 0.0 : (filterType == Type::HighPass ? -1.0 : 1.0))
+    {
+        if (type == Type::BandPass)
+        {
+            q = 1.4142135623730951; // 1 octave between the -3 dB points
+            k = 1.0 / q;
+        }
+    }
+
+    void prepare(double newSampleRate) override
+    {
+        sampleRate = newSampleRate;
+        piOverFs   = wdf_core::MathConstants<double>::pi / sampleRate;
+        cutoff     = std::clamp(cutoff, 20.0, sampleRate * 0.45);
+        reset();
+        updateCoefficients(cutoff);
+    }
+
+    /**
+     * @brief Clears the integrator states
+     */
+    void reset()
+    {
+        ic1 = 0.0;
+        ic2 = 0.0;
+    }
+
+    double processSample(double x) override
+    {
+        const Outputs y = processOutputs(x);
+        return mixInput * x + mixBand * y.bandPass + mixLow * y.lowPass;
+    }
+
+    /**
+     * @brief Processes one sample at its own cutoff, for audio-rate modulation
+     * @param x Input sample
+     * @param cutoffHz Cutoff for this and the following samples, clamped to [20 Hz, 0.45 Fs]
+     * @return Output selected by the filter type
+     */
+    double processSample(double x, double cutoffHz)
+    {
+        cutoff = std::clamp(cutoffHz, 20.0, sampleRate * 0.45);
+        updateCoefficients(cutoff);
+        return processSample(x);
+    }
+
+    /**
+     * @brief Advances the filter by one sample
+     * @param x Input sample
+     * @return Low-, high- and band-pass outputs
+     */
+    Outputs processOutputs(double x)
+    {
+        const double v3 = x - ic2;
+        const double v1 = a1 * ic1 + a2 * v3; // band-pass, gain Q at the cutoff
+        const double v2 = ic2 + a2 * ic1 + a3 * v3;
+        ic1             = 2.0 * v1 - ic1;
+        ic2             = 2.0 * v2 - ic2;
+
+        return {v2, x - k * v1 - v2, k * v1};
+    }
+
+    void processBlock(float* samples, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
+    }
+
+    void processBlockModulated(float* samples, const float* cutoffsHz, int numSamples) override
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i], cutoffsHz[i]));
+    }
+
+    void setCutoff(double newFc) override
+    {
+        newFc = std::clamp(newFc, 20.0, sampleRate * 0.45);
+        if (newFc == cutoff)
+            return;
+
+        cutoff = newFc;
+        updateCoefficients(cutoff);
+    }
+
+    /**
+     * @brief Sets the resonance; low- and high-pass default to 1/sqrt(2) (Butterworth)
+     * @param newQ Quality factor, clamped to [0.1, 50]
+     */
+    void setQ(double newQ)
+    {
+        newQ = std::clamp(newQ, 0.1, 50.0);
+        if (newQ == q)
+            return;
+
+        q = newQ;
+        k = 1.0 / q;
+        updateCoefficients(cutoff);
+    }
+
+    double getQ() const { return q; }
+
+    /**
+     * @brief Sets Q of the band-pass from the distance between its -3 dB points; ignored by the other types
+     * @param octaves Bandwidth in octaves (at least 0.1)
+     */
+    void setBandwidth(double octaves) override
+    {
+        if (type != Type::BandPass)
+            return;
+
+        octaves = std::max(0.1, octaves);
+        if (octaves == bandwidthInOctaves)
+            return;
+
+        bandwidthInOctaves = octaves;
+        const double ratio = std::pow(2.0, octaves);
+        setQ(std::sqrt(ratio) / (ratio - 1.0));
+    }
+
+    double getCutoff() const override { return cutoff; }
+
+    Type getType() const override { return type; }
+
+    Order getOrder() const override { return Order::Second; }
+
+    int getStateSize() const override { return 2; }
+
+    void getState(double* state) const override
+    {
+        state[0] = ic1;
+        state[1] = ic2;
+    }
+
+    void setState(const double* state) override
+    {
+        ic1 = state[0];
+        ic2 = state[1];
+    }
+
+private:
+    // a1 = 1 / (1 + g (g + k)), a2 = g a1, a3 = g a2, with g = n / d the Pade approximant of tan(w)
+    void updateCoefficients(double cutoffHz)
+    {
+        const double w  = piOverFs * cutoffHz;
+        const double w2 = w * w;
+        const double n  = w * (945.0 + w2 * (w2 - 105.0));
+        const double d  = 945.0 + w2 * (15.0 * w2 - 420.0);
+
+        const double scale = 1.0 / (d * d + n * (n + k * d));
+        a1                 = d * d * scale;
+        a2                 = n * d * scale;
+        a3                 = n * n * scale;
+    }
+
+    Type type;
+
+    // processSample() returns mixInput x + mixBand bandPass + mixLow lowPass, so the type costs no branch
+    double mixInput, mixBand, mixLow;
+
+    double ic1{0.0}, ic2{0.0}; // integrator states
+    double a1{0.0}, a2{0.0}, a3{0.0};
+
+    double sampleRate{44100.0}, piOverFs{wdf_core::MathConstants<double>::pi / 44100.0}, cutoff{1000.0};
+    double q{0.7071067811865476}, k{1.4142135623730951};
+    double bandwidthInOctaves{1.0}; // band-pass only
+};
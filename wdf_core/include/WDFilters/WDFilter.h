@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+
+#include <chowdsp_wdf/chowdsp_wdf.h>
+
+#include "wdf_core/MathConstants.h"
+
+namespace wdft = chowdsp::wdft;
+
+/**
+ * @brief Base abstract class for all WDF filters
+ *
+ * This serves as a common interface for all filter implementations,
+ * regardless of type (LP, HP, BP) or order (1st, 2nd, 3rd).
+ */
+class WDFilter
+{
+public:
+    enum class Type
+    {
+        LowPass,
+        HighPass,
+        BandPass
+    };
+
+    enum class Order
+    {
+        First,
+        Second
+    };
+
+    WDFilter()          = default;
+    virtual ~WDFilter() = default;
+
+    // The WDF implementations' adaptors hold references to sibling members, so no filter is copied or moved;
+    // keep them in place or behind a pointer (WDFilter::create())
+    WDFilter(const WDFilter&)            = delete;
+    WDFilter& operator=(const WDFilter&) = delete;
+    WDFilter(WDFilter&&)                 = delete;
+    WDFilter& operator=(WDFilter&&)      = delete;
+
+    /**
+     * @brief Prepares the filter for playback
+     * @param sampleRate Sample rate in Hz
+     */
+    virtual void prepare(double sampleRate) = 0;
+
+    /**
+     * @brief Processes a single audio sample
+     * @param x Input sample
+     * @return Filtered output sample
+     */
+    virtual double processSample(double x) = 0;
+
+    /**
+     * @brief Processes a block of audio samples in place
+     * @param samples Buffer of samples to filter
+     * @param numSamples Number of samples in the buffer
+     */
+    virtual void processBlock(float* samples, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = static_cast<float>(processSample(samples[i]));
+    }
+
+    /**
+     * @brief Processes a block in place with a cutoff per sample, for audio-rate modulation
+     *
+     * The default calls setCutoff() before every sample, which rebuilds the circuit each time;
+     * StateVariableFilter overrides it with a cheap coefficient update.
+     * @param samples Buffer of samples to filter
+     * @param cutoffsHz Cutoff frequency in Hz for each sample
+     * @param numSamples Number of samples in the buffer
+     */
+    virtual void processBlockModulated(float* samples, const float* cutoffsHz, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            setCutoff(cutoffsHz[i]);
+            samples[i] = static_cast<float>(processSample(samples[i]));
+        }
+    }
+
+    /**
+     * @brief Sets the cutoff frequency of the filter
+     * @param cutoffHz Cutoff frequency in Hz
+     */
+    virtual void setCutoff(double cutoffHz) = 0;
+
+    /**
+     * @brief Sets the bandwidth of band-pass filters; other filter types ignore it
+     *
+     * Cheap to call every block: implementations only recompute when the value changes.
+     * @param octaves Distance between the band edges in octaves
+     */
+    virtual void setBandwidth(double octaves) { (void) octaves; }
+
+    /**
+     * @brief Gets the current cutoff frequency
+     * @return Cutoff frequency in Hz
+     */
+    virtual double getCutoff() const = 0;
+
+    /**
+     * @brief Gets the filter type
+     * @return Filter type (LowPass, HighPass, BandPass)
+     */
+    virtual Type getType() const = 0;
+
+    /**
+     * @brief Gets the filter order
+     * @return Filter order (First, Second, Third)
+     */
+    virtual Order getOrder() const = 0;
+
+    /**
+     * @brief Gets the number of state variables, for filters that are linear and time-invariant
+     *
+     * The state is everything that carries one sample into the next: the reflected waves of the
+     * reactive elements, or the integrator states. With it, a render can be stopped and resumed, or
+     * split into chunks that are filtered independently and joined afterwards. Filters that are not
+     * linear, or keep state they cannot restore, return 0.
+     * @return Number of values getState() writes and setState() reads
+     */
+    virtual int getStateSize() const { return 0; }
+
+    /**
+     * @brief Copies the state out
+     * @param state Receives getStateSize() values
+     */
+    virtual void getState(double* state) const { (void) state; }
+
+    /**
+     * @brief Restores a state from getState(), or any linear combination of states
+     * @param state getStateSize() values
+     */
+    virtual void setState(const double* state) { (void) state; }
+
+    /**
+     * @brief Creates a new filter instance of the specified type and order
+     * @param type Filter type
+     * @param order Filter order
+     * @return Unique pointer to the created filter
+     */
+    static std::unique_ptr<WDFilter> create(Type type, Order order);
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace wdf_core
+{
+
+    /**
+     * @brief Mathematical constants in the precision of the DSP code that uses them
+     */
+    template <typename FloatType>
+    struct MathConstants
+    {
+        static constexpr FloatType pi    = static_cast<FloatType>(3.141592653589793238L);
+        static constexpr FloatType twoPi = static_cast<FloatType>(2 * 3.141592653589793238L);
+    };
+
+} // namespace wdf_core
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP > 0)
+#include <xmmintrin.h>
+#define WDF_CORE_HAS_SSE 1
+#endif
+
+namespace wdf_core
+{
+
+    /**
+     * @brief Enables flush-to-zero (and denormals-are-zero on x86) for the lifetime of the object
+     *
+     * Same role as juce::ScopedNoDenormals for hosts that call wdf_core without JUCE. Decaying
+     * filter states otherwise end up in subnormal floats, which are an order of magnitude slower.
+     */
+    class ScopedNoDenormals
+    {
+    public:
+        ScopedNoDenormals() noexcept
+        {
+#if defined(WDF_CORE_HAS_SSE)
+            savedState = _mm_getcsr();
+            _mm_setcsr(savedState | 0x8040); // FTZ | DAZ
+#elif defined(__aarch64__)
+            __asm__ __volatile__("mrs %0, fpcr" : "=r"(savedState));
+            const uint64_t flushed = savedState | (1ull << 24); // FZ
+            __asm__ __volatile__("msr fpcr, %0" : : "r"(flushed));
+#endif
+        }
+
+        ~ScopedNoDenormals() noexcept
+        {
+#if defined(WDF_CORE_HAS_SSE)
+            _mm_setcsr(savedState);
+#elif defined(__aarch64__)
+            __asm__ __volatile__("msr fpcr, %0" : : "r"(savedState));
+#endif
+        }
+
+        ScopedNoDenormals(const ScopedNoDenormals&)            = delete;
+        ScopedNoDenormals& operator=(const ScopedNoDenormals&) = delete;
+
+    private:
+#if defined(WDF_CORE_HAS_SSE)
+        unsigned int savedState = 0;
+#elif defined(__aarch64__)
+        uint64_t savedState = 0;
+#endif
+    };
+
+} // namespace wdf_core
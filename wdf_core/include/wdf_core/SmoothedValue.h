@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+
+namespace wdf_core
+{
+
+    namespace ValueSmoothingTypes
+    {
+        /** Constant step size: equal increments per sample */
+        struct Linear
+        {};
+
+        /** Constant ratio per sample, for frequencies and gains; values must not be zero */
+        struct Multiplicative
+        {};
+    } // namespace ValueSmoothingTypes
+
+    /**
+     * @brief Ramps a parameter towards its target over a fixed number of samples
+     *
+     * Same behaviour and interface as juce::SmoothedValue, so the DSP classes can be built
+     * without JUCE while producing identical output.
+     */
+    template <typename FloatType, typename SmoothingType = ValueSmoothingTypes::Linear>
+    class SmoothedValue
+    {
+    public:
+        /**
+         * @brief Sets the ramp length and stops any ramp in progress
+         * @param sampleRate Sample rate in Hz
+         * @param rampLengthInSeconds Duration of a ramp to a new target
+         */
+        void reset(double sampleRate, double rampLengthInSeconds) noexcept
+        {
+            assert(sampleRate > 0.0 && rampLengthInSeconds >= 0.0);
+            stepsToTarget = static_cast<int>(std::floor(rampLengthInSeconds * sampleRate));
+            setCurrentAndTargetValue(target);
+        }
+
+        void setCurrentAndTargetValue(FloatType newValue) noexcept
+        {
+            target = currentValue = newValue;
+            countdown             = 0;
+        }
+
+        /**
+         * @brief Starts a ramp from the current value to a new target
+         * @param newValue Target value
+         */
+        void setTargetValue(FloatType newValue) noexcept
+        {
+            if (newValue == target)
+                return;
+
+            if (stepsToTarget <= 0)
+            {
+                setCurrentAndTargetValue(newValue);
+                return;
+            }
+
+            target    = newValue;
+            countdown = stepsToTarget;
+            setStepSize();
+        }
+
+        /**
+         * @brief Advances the ramp by one sample
+         * @return The smoothed value for this sample
+         */
+        FloatType getNextValue() noexcept
+        {
+            if (!isSmoothing())
+                return target;
+
+            --countdown;
+
+            if (isSmoothing())
+                setNextValue();
+            else
+                currentValue = target;
+
+            return currentValue;
+        }
+
+        bool      isSmoothing() const noexcept { return countdown > 0; }
+        FloatType getCurrentValue() const noexcept { return currentValue; }
+        FloatType getTargetValue() const noexcept { return target; }
+
+    private:
+        void setStepSize() noexcept
+        {
+            if constexpr (std::is_same_v<SmoothingType, ValueSmoothingTypes::Multiplicative>)
+                step = std::exp((std::log(std::abs(target)) - std::log(std::abs(currentValue))) /
+                                static_cast<FloatType>(countdown));
+            else
+                step = (target - currentValue) / static_cast<FloatType>(countdown);
+        }
+
+        void setNextValue() noexcept
+        {
+            if constexpr (std::is_same_v<SmoothingType, ValueSmoothingTypes::Multiplicative>)
+                currentValue *= step;
+            else
+                currentValue += step;
+        }
+
+        // Multiplicative ramps cannot start from zero, so they start from one like JUCE's
+        static constexpr FloatType initialValue =
+            std::is_same_v<SmoothingType, ValueSmoothingTypes::Multiplicative> ? FloatType(1) : FloatType(0);
+
+        FloatType currentValue  = initialValue;
+        FloatType target        = initialValue;
+        FloatType step          = 0;
+        int       countdown     = 0;
+        int       stepsToTarget = 0;
+    };
+
+} // namespace wdf_core
@@ -0,0 +1,299 @@
+#include "WDFilters/CascadeDesign.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+
+#include "wdf_core/MathConstants.h"
+
+namespace wdf_core
+{
+
+    static void addSection(CascadePrototype& prototype, double omega, double q)
+    {
+        assert(prototype.numSections < maxPrototypeSections);
+        prototype.sections[static_cast<size_t>(prototype.numSections++)] = {omega, q};
+    }
+
+    static CascadePrototype butterworthPrototype(int order)
+    {
+        CascadePrototype prototype;
+        prototype.order = order;
+
+        // Poles on the unit circle at angles (2k - 1) pi / 2N from the imaginary axis
+        for (int k = 1; k <= order / 2; ++k)
+        {
+            const double angle = (2.0 * k - 1.0) * MathConstants<double>::pi / (2.0 * order);
+            addSection(prototype, 1.0, 1.0 / (2.0 * std::sin(angle)));
+        }
+        if (order % 2 != 0)
+            addSection(prototype, 1.0, 0.0);
+
+        return prototype;
+    }
+
+    static CascadePrototype besselPrototype(int order)
+    {
+        // Reverse Bessel polynomial: a_k = (2N - k)! / (2^(N - k) k! (N - k)!), monic (a_N = 1)
+        std::array<double, maxCascadeOrder + 1> coefficients{};
+        for (int k = 0; k <= order; ++k)
+        {
+            double value = 1.0;
+            for (int i = order - k + 1; i <= 2 * order - k; ++i) // (2N - k)! / (N - k)!
+                value *= i;
+            for (int i = 2; i <= k; ++i)
+                value /= i;
+            coefficients[static_cast<size_t>(k)] = std::ldexp(value, k - order);
+        }
+
+        auto evaluate = [&](std::complex<double> s) {
+            std::complex<double> result = coefficients[static_cast<size_t>(order)];
+            for (int k = order - 1; k >= 0; --k)
+                result = result * s + coefficients[static_cast<size_t>(k)];
+            return result;
+        };
+
+        // Durand-Kerner iteration; converges reliably for these well-separated roots
+        std::array<std::complex<double>, maxCascadeOrder> roots{};
+        const double                                       radius = std::pow(coefficients[0], 1.0 / order);
+        for (int i = 0; i < order; ++i)
+            roots[static_cast<size_t>(i)] = radius * std::pow(std::complex<double>(0.4, 0.9), i);
+
+        for (int iteration = 0; iteration < 500; ++iteration)
+        {
+            double largestStep = 0.0;
+            for (int i = 0; i < order; ++i)
+            {
+                std::complex<double> denominator = 1.0;
+                for (int j = 0; j < order; ++j)
+                    if (j != i)
+                        denominator *= roots[static_cast<size_t>(i)] - roots[static_cast<size_t>(j)];
+
+                const auto step = evaluate(roots[static_cast<size_t>(i)]) / denominator;
+                roots[static_cast<size_t>(i)] -= step;
+                largestStep = std::max(largestStep, std::abs(step) / radius);
+            }
+            if (largestStep < 1.0e-14)
+                break;
+        }
+
+        // Rescale so that |H(j)| = 1/sqrt(2); |H| falls monotonically, so bisect on the -3 dB frequency
+        auto magnitudeSquared = [&](double omega) {
+            return coefficients[0] * coefficients[0] / std::norm(evaluate({0.0, omega}));
+        };
+        double low = 1.0e-3, high = 1.0e3;
+        for (int i = 0; i < 200; ++i)
+        {
+            const double mid = std::sqrt(low * high);
+            (magnitudeSquared(mid) > 0.5 ? low : high) = mid;
+        }
+        const double cutoff = std::sqrt(low * high);
+
+        CascadePrototype prototype;
+        prototype.order = order;
+        for (int i = 0; i < order; ++i)
+        {
+            const auto pole = roots[static_cast<size_t>(i)] / cutoff;
+            if (std::abs(pole.imag()) < 1.0e-9 * std::abs(pole))
+                addSection(prototype, -pole.real(), 0.0);
+            else if (pole.imag() > 0.0) // one section per conjugate pair
+                addSection(prototype, std::abs(pole), std::abs(pole) / (-2.0 * pole.real()));
+        }
+        return prototype;
+    }
+
+    CascadePrototype designCascadePrototype(Alignment alignment, int order)
+    {
+        order = std::clamp(order, 1, maxCascadeOrder);
+
+        CascadePrototype prototype;
+        switch (alignment)
+        {
+        case Alignment::Butterworth:
+            prototype = butterworthPrototype(order);
+            break;
+        case Alignment::Bessel:
+            prototype = besselPrototype(order);
+            break;
+        case Alignment::LinkwitzRiley:
+        {
+            // Butterworth of half the order, squared; a doubled real pole becomes a Q = 0.5 section
+            const int  half = std::max(1, (order + 1) / 2);
+            const auto base = butterworthPrototype(half);
+            prototype.order = 2 * half;
+            for (int i = 0; i < base.numSections; ++i)
+            {
+                const auto& section = base.sections[static_cast<size_t>(i)];
+                if (section.isFirstOrder())
+                {
+                    addSection(prototype, section.omega, 0.5);
+                }
+                else
+                {
+                    addSection(prototype, section.omega, section.q);
+                    addSection(prototype, section.omega, section.q);
+                }
+            }
+            break;
+        }
+        default:
+            assert(false && "Unknown alignment");
+            return butterworthPrototype(order);
+        }
+
+        // Lowest Q first keeps the resonant peaks of later sections from overloading earlier ones
+        for (size_t i = 1; i < static_cast<size_t>(prototype.numSections); ++i)
+            for (size_t j = i; j > 0 && prototype.sections[j].q < prototype.sections[j - 1].q; --j)
+                std::swap(prototype.sections[j], prototype.sections[j - 1]);
+        return prototype;
+    }
+
+    SectionComponents designSectionComponents(const PrototypeSection& section,
+                                              bool                    highPass,
+                                              double                  cutoffRadians,
+                                              double                  capacitance)
+    {
+        // The high-pass transform s -> 1/s maps a pole at omega to 1/omega and keeps Q
+        const double omega = highPass ? cutoffRadians / section.omega : cutoffRadians * section.omega;
+
+        SectionComponents components;
+        components.C = capacitance;
+        if (section.isFirstOrder())
+        {
+            components.R = 1.0 / (omega * capacitance);
+        }
+        else
+        {
+            // omega0 = 1 / sqrt(LC), Q = sqrt(L / C) / R
+            components.L = 1.0 / (omega * omega * capacitance);
+            components.R = std::sqrt(components.L / capacitance) / section.q;
+        }
+        return components;
+    }
+
+    SectionCoefficients designSectionCoefficients(const PrototypeSection& section,
+                                                  SectionOutput           output,
+                                                  double                  cutoffRadians,
+                                                  double                  sampleRate,
+                                                  double                  capacitance)
+    {
+        const bool highPass = output == SectionOutput::HighPass;
+        const auto parts    = designSectionComponents(section, highPass, cutoffRadians, capacitance);
+
+        // Port resistances of the series adaptor: R, 2 L fs for the inductor, 1 / (2 C fs) for the capacitor
+        const double rL    = 2.0 * parts.L * sampleRate;
+        const double rC    = 1.0 / (2.0 * parts.C * sampleRate);
+        const double total = parts.R + rL + rC;
+        const double gL    = rL / total;
+        const double gC    = rC / total;
+
+        // The output is the negated voltage across C (low-pass), L or R (high-pass); the all-pass
+        // output Vs - 2 V_R = u + zL - zC - 2 gR u, with gR = 1 - gC - gL
+        switch (output)
+        {
+        case SectionOutput::LowPass:
+            return {2.0 * gC, 2.0 * gL, gC, -1.0, 0.0};
+        case SectionOutput::HighPass:
+            if (section.isFirstOrder())
+                return {2.0 * gC, 2.0 * gL, 1.0 - gC, 0.0, 0.0};
+            return {2.0 * gC, 2.0 * gL, gL, 0.0, 1.0};
+        case SectionOutput::AllPass:
+            return {2.0 * gC, 2.0 * gL, 2.0 * (gC + gL) - 1.0, -1.0, 1.0};
+        default:
+            assert(false && "Unknown section output");
+            return {};
+        }
+    }
+
+    // |H(jx)|^2 of one section built with C = 1: the series loop gives V_C / V = 1 / (1 - x^2 L + j x R)
+    static double sectionMagnitudeSquared(const SectionComponents& parts, bool highPass, double x)
+    {
+        const double re = 1.0 - x * x * parts.L;
+        const double im = x * parts.R;
+
+        double numerator = 1.0; // capacitor voltage (low-pass)
+        if (highPass)
+            numerator = parts.L > 0.0 ? x * x * parts.L * x * x * parts.L : im * im; // inductor or resistor voltage
+        return numerator / (re * re + im * im);
+    }
+
+    BandPassGainTable designBandPassGainTable(const CascadePrototype& prototype)
+    {
+        // Both halves at a corner of 1 rad/s; the low-pass with its corner at r is evaluated at x / r
+        std::array<SectionComponents, maxPrototypeSections> highPassParts{}, lowPassParts{};
+        for (size_t i = 0; i < static_cast<size_t>(prototype.numSections); ++i)
+        {
+            highPassParts[i] = designSectionComponents(prototype.sections[i], true, 1.0, 1.0);
+            lowPassParts[i]  = designSectionComponents(prototype.sections[i], false, 1.0, 1.0);
+        }
+
+        auto magnitudeSquared = [&](double ratio, double octave) {
+            const double x      = std::exp2(octave);
+            double       result = 1.0;
+            for (size_t i = 0; i < static_cast<size_t>(prototype.numSections); ++i)
+                result *= sectionMagnitudeSquared(highPassParts[i], true, x)
+                          * sectionMagnitudeSquared(lowPassParts[i], false, x / ratio);
+            return result;
+        };
+
+        BandPassGainTable table;
+        for (size_t n = 0; n < BandPassGainTable::size; ++n)
+        {
+            const double octaves = static_cast<double>(n) / BandPassGainTable::stepsPerOctave;
+            const double ratio   = std::exp2(octaves);
+
+            // Coarse scan from two octaves below the high-pass corner to two above the low-pass corner...
+            constexpr double scanStep   = 0.125;
+            double           bestOctave = -2.0;
+            double           best       = magnitudeSquared(ratio, bestOctave);
+            for (double octave = -2.0 + scanStep; octave <= octaves + 2.0; octave += scanStep)
+            {
+                const double value = magnitudeSquared(ratio, octave);
+                if (value > best)
+                {
+                    best       = value;
+                    bestOctave = octave;
+                }
+            }
+
+            // ...then a golden-section search around the best grid point
+            constexpr double golden = 0.6180339887498949;
+            double           low = bestOctave - scanStep, high = bestOctave + scanStep;
+            for (int i = 0; i < 40; ++i)
+            {
+                const double a = high - golden * (high - low);
+                const double b = low + golden * (high - low);
+                if (magnitudeSquared(ratio, a) < magnitudeSquared(ratio, b))
+                    low = a;
+                else
+                    high = b;
+            }
+            best = std::max(best, magnitudeSquared(ratio, (low + high) / 2.0));
+
+            table.gains[n] = 1.0 / std::sqrt(best);
+        }
+        return table;
+    }
+
+    double BandPassGainTable::getGain(double cornerRatio) const noexcept
+    {
+        const double position = std::max(0.0, std::log2(cornerRatio) * stepsPerOctave); // also catches NaN
+        if (position >= static_cast<double>(size - 1))
+            return gains[size - 1];
+
+        const auto   index    = static_cast<size_t>(position);
+        const double fraction = position - static_cast<double>(index);
+
+        // Catmull-Rom through the neighbouring entries, extrapolated linearly at both ends
+        const double g1 = gains[index];
+        const double g2 = gains[index + 1];
+        const double g0 = index > 0 ? gains[index - 1] : 2.0 * g1 - g2;
+        const double g3 = index + 2 < size ? gains[index + 2] : 2.0 * g2 - g1;
+        const double c1 = g2 - g0;
+        const double c2 = 2.0 * g0 - 5.0 * g1 + 4.0 * g2 - g3;
+        const double c3 = 3.0 * (g1 - g2) + g3 - g0;
+        return g1 + 0.5 * fraction * (c1 + fraction * (c2 + fraction * c3));
+    }
+
+} // namespace wdf_core
@@ -1,5 +1,7 @@
 #include "WDFilters/WDFilter.h"
 
+#include <cassert>
+
 #include "WDFilters/BandPassFilter.h"
 #include "WDFilters/HighPassFilter.h"
 #include "WDFilters/LowPassFilter.h"
@@ -16,7 +18,7 @@ std::unique_ptr<WDFilter> WDFilter::create(Type type, Order order)
         case Order::Second:
             return std::make_unique<WDFRC2LowPassCascade>();
         default:
-            jassertfalse;
+            assert(false && "Unknown filter order");
             return std::make_unique<WDFRCLowPass>();
         }
     case Type::HighPass:
@@ -27,7 +29,7 @@ std::unique_ptr<WDFilter> WDFilter::create(Type type, Order order)
         case Order::Second:
             return std::make_unique<WDFRC2HighPassCascade>();
         default:
-            jassertfalse;
+            assert(false && "Unknown filter order");
             return std::make_unique<WDFRCHighPass>();
         }
     case Type::BandPass:
@@ -38,12 +40,12 @@ std::unique_ptr<WDFilter> WDFilter::create(Type type, Order order)
         case Order::Second:
             return std::make_unique<WDFRCBandPass2nd>();
         default:
-            jassertfalse;
+            assert(false && "Unknown filter order");
             return std::make_unique<WDFRCBandPass1st>();
         }
 
     default:
-        jassertfalse; // Unknown filter type
+        assert(false && "Unknown filter type");
         return std::make_unique<WDFRCLowPass>();
     }
 }